@@ -0,0 +1,473 @@
+/******************************************************************************
+ * File: BoundedSearch.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of memory-bounded shortest path search in the style of
+ *   simplified memory-bounded A* (SMA*).
+ * http://en.wikipedia.org/wiki/SMA*
+ */
+
+#include "BoundedSearch.h"
+#include "error.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <set>
+
+using namespace std;
+
+/*
+ * What the search remembers about each cell it has stored.  This replaces
+ *   the parentNode / nodeCosts / nodeColors grids in shortestPath with a
+ *   single entry per stored cell.
+ *   cost:      cheapest known cost from start to this cell
+ *   estimate:  estimated cost of a full path through this cell (cost plus
+ *              heuristic, never less than the parent's estimate)
+ *   priority:  this cell's priority in the open queue, if it is queued
+ *   backedUp:  for each successor (see successorIndex), the estimate it had
+ *              when it was last forgotten, or 0 if it never was; infinity
+ *              marks a dead end, which is never regenerated from here
+ *   forgotten: one bit per successor forgotten since this cell was last
+ *              expanded
+ *   children:  number of stored cells whose parent is this cell
+ *   depth:     number of steps from start to this cell
+ */
+struct BoundedNode {
+    double cost;
+    double estimate;
+    double priority;
+    double backedUp[8];
+    int forgotten;
+    Loc parent;
+    int children;
+    int depth;
+    bool queued;
+};
+
+/*
+ * Return a newly stored cell with nothing forgotten below it.
+ */
+static BoundedNode makeNode(double cost, double estimate, Loc parent,
+                            int depth) {
+    BoundedNode node;
+    node.cost = cost;
+    node.estimate = estimate;
+    node.priority = 0.0;
+    fill(node.backedUp, node.backedUp + 8, 0.0);
+    node.forgotten = 0;
+    node.parent = parent;
+    node.children = 0;
+    node.depth = depth;
+    node.queued = false;
+    return node;
+}
+
+/*
+ * Return the index (0 to 7) of the move from a cell to one of its eight
+ *   neighbors, as used by BoundedNode::backedUp and BoundedNode::forgotten.
+ */
+static int successorIndex(Loc from, Loc to) {
+    int direction = (to.row - from.row + 1) * 3 + (to.col - from.col + 1);
+    return direction > 4 ? direction - 1 : direction;
+}
+
+/*
+ * Return the lowest estimate among the successors of a cell that were
+ *   forgotten since it was last expanded (infinity if there are none).
+ */
+static double lowestForgotten(const BoundedNode& node) {
+    double lowest = numeric_limits<double>::infinity();
+    for (int i = 0; i < 8; i++) {
+        if (node.forgotten & (1 << i)) lowest = min(lowest, node.backedUp[i]);
+    }
+    return lowest;
+}
+
+/*
+ * Constant: kExpansionsPerCell
+ *
+ * How many expansions the search may make per cell of the world before it
+ *   gives up.  Unlimited A* expands each cell at most once, so a search that
+ *   has spent many times that is regenerating the same cells over and over.
+ *   Past that point the work grows so fast as the limit gets tighter that
+ *   giving up costs only a few times what an unlimited search would.
+ */
+const long long kExpansionsPerCell = 16;
+
+/*
+ * Helper class holding the state of one memory-bounded search.
+ * Stored cells live in a std::map so that references to them stay valid as
+ *   other cells are added and removed.  Cells waiting to be expanded are
+ *   kept in an ordered set (rather than TrailblazerPQueue) because forgetting
+ *   a cell has to be able to pull it back out of the queue.  Stored cells
+ *   with no stored children are the only ones that can be forgotten without
+ *   breaking a chain of parents, so they are kept in a second ordered set
+ *   keyed on their estimate.
+ */
+class BoundedSearch {
+public:
+    BoundedSearch(Loc start, Loc end, Grid<double>& world,
+                  double costFn(Loc, Loc, Grid<double>&),
+                  double heuristic(Loc, Loc, Grid<double>&),
+                  int maxNodes);
+
+    // run the search and return the path from start to end
+    Vector<Loc> run();
+
+private:
+    /*
+     * Key for both ordered sets: estimate first, then deeper (i.e., more
+     *   costly to reach) cells first.  The open queue is expanded from the
+     *   front and leaves are forgotten from the back, so among equally
+     *   promising cells the search pushes deeper and forgets shallower ones,
+     *   which stops it from swapping two equally good branches in and out
+     *   of memory forever.
+     */
+    struct Entry {
+        double estimate;
+        double cost;
+        Loc loc;
+        Entry(double estimate, double cost, Loc loc)
+            : estimate(estimate), cost(cost), loc(loc) {}
+        bool operator <(const Entry& other) const {
+            if (estimate != other.estimate) return estimate < other.estimate;
+            if (cost != other.cost) return cost > other.cost;
+            return loc < other.loc;
+        }
+    };
+
+    Loc start;
+    Loc end;
+    Grid<double>& world;
+    double (*costFn)(Loc, Loc, Grid<double>&);
+    double (*heuristic)(Loc, Loc, Grid<double>&);
+    int maxNodes;
+    Loc expanding;
+
+    // expansions left before the search gives up (see kExpansionsPerCell)
+    long long expansionsLeft;
+
+    map<Loc, BoundedNode> nodes;
+    set<Entry> open;
+    set<Entry> leaves;
+
+    // place a stored cell in the open queue with the given priority, or
+    //   lower its priority if it is already there
+    void enqueue(Loc loc, BoundedNode& node, double priority);
+
+    // keep the leaf set in step with a cell's estimate and children
+    void removeLeaf(Loc loc, BoundedNode& node);
+    void addLeaf(Loc loc, BoundedNode& node);
+
+    // return what a stored child tells its parent about paths through it
+    double childEstimate(Loc parentLoc, BoundedNode& parent,
+                         Loc loc, BoundedNode& child);
+
+    // raise the estimate of an expanded cell to the lowest estimate among
+    //   its successors, passing the change on up through its ancestors
+    void backUp(Loc loc);
+
+    // forget the worst leaf; returns false if nothing can be forgotten
+    bool forgetWorstLeaf();
+
+    // follow parent links back from end to build the final path
+    Vector<Loc> tracePath();
+};
+
+BoundedSearch::BoundedSearch(Loc start, Loc end, Grid<double>& world,
+                             double costFn(Loc, Loc, Grid<double>&),
+                             double heuristic(Loc, Loc, Grid<double>&),
+                             int maxNodes)
+    : start(start), end(end), world(world), costFn(costFn),
+      heuristic(heuristic), maxNodes(maxNodes),
+      expanding(start),
+      expansionsLeft(kExpansionsPerCell *
+                     (long long) world.numRows() * world.numCols()) {
+}
+
+void BoundedSearch::enqueue(Loc loc, BoundedNode& node, double priority) {
+    if (node.queued) {
+        if (node.priority <= priority) return;
+        open.erase(Entry(node.priority, node.cost, loc));
+    }
+    node.queued = true;
+    node.priority = priority;
+    open.insert(Entry(priority, node.cost, loc));
+}
+
+void BoundedSearch::removeLeaf(Loc loc, BoundedNode& node) {
+    if (node.children == 0) {
+        leaves.erase(Entry(node.estimate, node.cost, loc));
+    }
+}
+
+void BoundedSearch::addLeaf(Loc loc, BoundedNode& node) {
+    // the start cell anchors every path, so it is never forgotten; nor is
+    //   the cell currently being expanded
+    if (node.children == 0 && loc != start && loc != expanding) {
+        leaves.insert(Entry(node.estimate, node.cost, loc));
+    }
+}
+
+/*
+ * A cell that is moved under a cheaper parent keeps its stored children,
+ *   whose costs are then out of date until the cell is expanded again and
+ *   moves them along with it.  Their estimates (possibly infinite, if every
+ *   way on looked more costly than a route already stored) describe the old
+ *   route, so in the meantime the parent falls back on the estimate a fresh
+ *   copy of the child would get.
+ */
+double BoundedSearch::childEstimate(Loc parentLoc, BoundedNode& parent,
+                                    Loc loc, BoundedNode& child) {
+    double fresh = parent.cost + costFn(parentLoc, loc, world);
+    if (child.cost == fresh) return child.estimate;
+    return fresh + heuristic(loc, end, world);
+}
+
+/*
+ * Every successor of an expanded cell is either stored as its child, was
+ *   forgotten, or is reached more cheaply some other way, so the lowest
+ *   estimate among its children and forgotten successors is a lower bound on
+ *   any path through it.  Raising estimates this way is what lets the search
+ *   make progress after forgetting: a regenerated cell starts out no lower
+ *   than its parent's estimate, rather than back at cost plus heuristic.
+ */
+void BoundedSearch::backUp(Loc loc) {
+    // the cell being expanded has not seen all its successors yet
+    while (loc != expanding) {
+        BoundedNode& node = nodes[loc];
+        double best = lowestForgotten(node);
+        for (int row = loc.row - 1; row < loc.row + 2; row++) {
+            for (int col = loc.col - 1; col < loc.col + 2; col++) {
+                if (row == loc.row && col == loc.col) continue;
+                map<Loc, BoundedNode>::iterator itr =
+                    nodes.find(makeLoc(row, col));
+                if (itr != nodes.end() && itr->second.parent == loc) {
+                    best = min(best, childEstimate(loc, node, itr->first,
+                                                   itr->second));
+                }
+            }
+        }
+        if (best <= node.estimate) return;
+
+        removeLeaf(loc, node);
+        node.estimate = best;
+        addLeaf(loc, node);
+        if (loc == start) return;
+        loc = node.parent;
+    }
+}
+
+/*
+ * Forget the leaf with the highest estimate.  Its parent records the
+ *   estimate it lost and goes back into the open queue, so that if the
+ *   forgotten branch ever becomes the most promising one again, the parent
+ *   will be expanded again and regenerate it.  The estimate is kept for that
+ *   one successor rather than folded into a single value for the parent:
+ *   otherwise a regenerated cell would start again from its parent's
+ *   estimate, everything the search had learned below it would be lost, and
+ *   with a tight limit the search could go on swapping the same cells in
+ *   and out forever.
+ */
+bool BoundedSearch::forgetWorstLeaf() {
+    if (leaves.empty()) return false;
+
+    set<Entry>::iterator worst = leaves.end();
+    worst--;
+    Loc loc = worst->loc;
+    leaves.erase(worst);
+
+    BoundedNode& node = nodes[loc];
+    if (node.queued) open.erase(Entry(node.priority, node.cost, loc));
+    Loc parentLoc = node.parent;
+    BoundedNode& parent = nodes[parentLoc];
+    double estimate = childEstimate(parentLoc, parent, loc, node);
+    nodes.erase(loc);
+
+    parent.children--;
+    int index = successorIndex(parentLoc, loc);
+    parent.backedUp[index] = estimate;
+    parent.forgotten |= 1 << index;
+    addLeaf(parentLoc, parent);
+    backUp(parentLoc);
+    double lowest = lowestForgotten(parent);
+    if (lowest != numeric_limits<double>::infinity()) {
+        enqueue(parentLoc, parent, lowest);
+    }
+    return true;
+}
+
+Vector<Loc> BoundedSearch::tracePath() {
+    Vector<Loc> tempReversePath;
+    Loc curr = end;
+    while (curr != start) {
+        tempReversePath += curr;
+        curr = nodes[curr].parent;
+    }
+    tempReversePath += start;
+
+    Vector<Loc> finalPath;
+    for (int i = tempReversePath.size() - 1; i >= 0; i--) {
+        finalPath += tempReversePath[i];
+    }
+    return finalPath;
+}
+
+Vector<Loc> BoundedSearch::run() {
+    double infinity = numeric_limits<double>::infinity();
+
+    BoundedNode& first = nodes[start];
+    first = makeNode(0.0, heuristic(start, end, world), start, 0);
+    enqueue(start, first, first.estimate);
+
+    // whether any cell was passed over because of the node limit
+    bool tooDeep = false;
+
+    while (!open.empty()) {
+        // only dead ends are left
+        if (open.begin()->estimate == infinity) break;
+
+        Loc curr = open.begin()->loc;
+        open.erase(open.begin());
+        BoundedNode& currNode = nodes[curr];
+        currNode.queued = false;
+
+        if (curr == end) return tracePath();
+
+        // the limit is so tight that the search keeps swapping the same
+        //   cells in and out of memory rather than getting anywhere
+        if (--expansionsLeft < 0) {
+            error("The node limit is too small to find a path.");
+        }
+
+        // this expansion regenerates every missing successor, so start the
+        //   record of what has been forgotten afresh; also make sure the
+        //   cell being expanded can't itself be forgotten partway through
+        currNode.forgotten = 0;
+        removeLeaf(curr, currNode);
+        expanding = curr;
+        int numStored = 0;
+        bool outOfRoom = false;
+
+        for (int row = curr.row - 1; row < curr.row + 2; row++) {
+            for (int col = curr.col - 1; col < curr.col + 2; col++) {
+                if (row == curr.row && col == curr.col) continue;
+                if (!world.inBounds(row, col)) continue;
+
+                Loc v = makeLoc(row, col);
+                int index = successorIndex(curr, v);
+                if (currNode.backedUp[index] == infinity) continue;
+                double edgeCost = costFn(curr, v, world);
+                if (edgeCost == infinity) continue;
+                double vPathCost = currNode.cost + edgeCost;
+
+                // a path through v would need more cells than the limit
+                //   allows, so v is as good as a dead end
+                if (v != end && currNode.depth + 2 >= maxNodes) {
+                    tooDeep = true;
+                    continue;
+                }
+                double vEstimate = max(max(currNode.estimate,
+                                           currNode.backedUp[index]),
+                                       vPathCost + heuristic(v, end, world));
+
+                map<Loc, BoundedNode>::iterator itr = nodes.find(v);
+                if (itr != nodes.end()) {
+                    // already stored; only interesting if this is a cheaper
+                    //   way to reach it, in which case it moves under curr
+                    BoundedNode& node = itr->second;
+                    if (node.cost <= vPathCost) continue;
+
+                    Loc oldParentLoc = node.parent;
+                    BoundedNode& oldParent = nodes[oldParentLoc];
+                    oldParent.children--;
+                    addLeaf(oldParentLoc, oldParent);
+
+                    // its keys depend on its cost, so take it out of both
+                    //   sets before changing anything
+                    removeLeaf(v, node);
+                    if (node.queued) {
+                        open.erase(Entry(node.priority, node.cost, v));
+                        node.queued = false;
+                    }
+                    node.cost = vPathCost;
+                    node.estimate = vEstimate;
+                    node.parent = curr;
+                    node.depth = currNode.depth + 1;
+
+                    // what was learned below it no longer applies at its
+                    //   new cost and depth, and until it is expanded again
+                    //   nothing is known about where it leads, so count
+                    //   every successor as forgotten with no estimate yet
+                    fill(node.backedUp, node.backedUp + 8, 0.0);
+                    node.forgotten = 0xFF;
+                    addLeaf(v, node);
+                    currNode.children++;
+                    enqueue(v, node, vEstimate);
+                    numStored++;
+
+                    // the old parent lost a successor, which can only raise
+                    //   the lower bound on paths through it
+                    backUp(oldParentLoc);
+                    continue;
+                }
+
+                // out of room: forget something else, or failing that, this
+                //   successor (curr will be requeued to regenerate it)
+                if (int(nodes.size()) >= maxNodes && !forgetWorstLeaf()) {
+                    currNode.backedUp[index] = vEstimate;
+                    currNode.forgotten |= 1 << index;
+                    outOfRoom = true;
+                    continue;
+                }
+
+                BoundedNode& node = nodes[v];
+                node = makeNode(vPathCost, vEstimate, curr, currNode.depth + 1);
+                addLeaf(v, node);
+                currNode.children++;
+                enqueue(v, node, vEstimate);
+                numStored++;
+            }
+        }
+        expanding = start;
+
+        // a cell with nowhere new to go ends up with an infinite estimate,
+        //   so it is forgotten first and never regenerated
+        backUp(curr);
+
+        double lowest = lowestForgotten(currNode);
+        if (lowest != infinity) {
+            // every stored cell lies on the way to curr, so there is no room
+            //   left to make any progress
+            if (outOfRoom && numStored == 0) {
+                error("The node limit is too small to find a path.");
+            }
+            enqueue(curr, currNode, lowest);
+        }
+        addLeaf(curr, currNode);
+    }
+    if (tooDeep) error("The node limit is too small to find a path.");
+    error("No path exists between the start and end locations.");
+    return Vector<Loc>();
+}
+
+Vector<Loc>
+boundedShortestPath(Loc start,
+                    Loc end,
+                    Grid<double>& world,
+                    double costFn(Loc from, Loc to, Grid<double>& world),
+                    double heuristic(Loc start, Loc end, Grid<double>& world),
+                    int maxNodes) {
+    if (maxNodes < 1) error("The node limit must be positive.");
+
+    // every step changes the row and the column by at most one, so any path
+    //   needs at least this many cells; with fewer there is nothing to search
+    int minCells = max(abs(end.row - start.row), abs(end.col - start.col)) + 1;
+    if (maxNodes < minCells) {
+        error("The node limit is too small to find a path.");
+    }
+    BoundedSearch search(start, end, world, costFn, heuristic, maxNodes);
+    return search.run();
+}
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * File: BoundedSearch.h
+ *
+ * Eric Beach
+ *
+ * Memory-bounded shortest path search.  shortestPath allocates several grids
+ *   the size of the whole world for every query; this search instead stores
+ *   only the cells it actually touches and never stores more than a fixed
+ *   number of them, re-expanding cells when it runs out of room.
+ * http://en.wikipedia.org/wiki/SMA*
+ */
+
+#ifndef __Trailblazer__BoundedSearch__
+#define __Trailblazer__BoundedSearch__
+
+#include "TrailblazerTypes.h"
+#include "vector.h"
+#include "grid.h"
+
+/* Function: boundedShortestPath
+ *
+ * Finds the shortest path between start and end, storing search information
+ *   for at most maxNodes cells at a time.
+ *
+ * This is A* search in which the cells it touches are stored sparsely.  If
+ *   the search finishes within maxNodes cells it returns a path of the same
+ *   (optimal) cost as shortestPath, though ties may be broken differently.
+ *   Otherwise, whenever the limit is reached, the stored leaf cell that looks
+ *   worst (i.e., has the highest estimated total cost) is forgotten and its
+ *   parent is queued up to regenerate it later if it turns out to be needed
+ *   after all (as in SMA*).  The search still returns an
+ *   optimal path so long as maxNodes is enough to hold that path plus the
+ *   cells around it being compared against; it just re-expands cells as the
+ *   limit gets tighter.  The amount of re-expansion grows very quickly once
+ *   the limit is well below the number of cells shortestPath would visit,
+ *   so the limit is best set only somewhat below that.
+ * If no path is found, or the limit is too small to hold any path to the
+ *   end, this function reports an error.  A path needs at least one cell more
+ *   than the larger of the row and column distances between start and end,
+ *   so a limit below that is reported right away.  A limit that holds a path
+ *   but leaves too little room around it is reported as too small once the
+ *   search has made 16 expansions for every cell of the world, rather than
+ *   letting it re-expand without end.
+ */
+Vector<Loc>
+boundedShortestPath(Loc start,
+                    Loc end,
+                    Grid<double>& world,
+                    double costFn(Loc from, Loc to, Grid<double>& world),
+                    double heuristic(Loc start, Loc end, Grid<double>& world),
+                    int maxNodes);
+
+#endif /* defined(__Trailblazer__BoundedSearch__) */
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * File: BoundedSearchTest.h
+ *
+ * Eric Beach
+ *
+ * Checks that the memory-bounded search finds paths as cheap as plain A* on
+ *   generated terrains and mazes, both with room to spare and with a tight
+ *   node limit, and that it reports an error when no path can fit.
+ *
+ * These searches take a noticeable fraction of a second, so they are not run
+ *   on every launch; build with -DRUN_BOUNDED_SEARCH_TESTS to run them at
+ *   startup along with the union-find tests.
+ */
+
+#ifndef Trailblazer_BoundedSearchTest_h
+#define Trailblazer_BoundedSearchTest_h
+
+#include "BoundedSearch.h"
+#include "MultiGoalSearch.h"
+#include "TrailblazerCosts.h"
+#include "WorldGenerator.h"
+#include "error.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+
+////////// HELPERS //////////
+// number of seeded terrains and mazes the test searches
+const int kBoundedTestWorlds = 4;
+
+// the error the search reports when the node limit leaves no way through
+const char* const kLimitTooSmall =
+    "The node limit is too small to find a path.";
+
+// the cells the reference search has stored, and the cost function it
+//   wraps; a cell is stored the first time an edge into it is costed
+Grid<bool> boundedTestStored;
+int boundedTestNumStored;
+double (*boundedTestCostFn)(Loc, Loc, Grid<double>&);
+
+// costs a move with boundedTestCostFn, counting the cells it reaches
+double countingCost(Loc from, Loc to, Grid<double>& world) {
+    if (!boundedTestStored[to.row][to.col]) {
+        boundedTestStored[to.row][to.col] = true;
+        boundedTestNumStored++;
+    }
+    return boundedTestCostFn(from, to, world);
+}
+
+// total cost of walking along a path
+double boundedTestPathCost(Vector<Loc>& path,
+                           Grid<double>& world,
+                           double costFn(Loc, Loc, Grid<double>&)) {
+    double cost = 0.0;
+    for (int i = 1; i < path.size(); i++) {
+        cost += costFn(path[i - 1], path[i], world);
+    }
+    return cost;
+}
+
+// whether two path costs agree up to rounding in the order they were summed
+bool boundedTestSameCost(double a, double b) {
+    return fabs(a - b) <= 1e-9 * (1.0 + fabs(a));
+}
+
+// checks that a path found by the bounded search runs from start to end and
+//   costs the same as the reference path
+void checkBoundedPath(Vector<Loc>& path,
+                      Loc start,
+                      Loc end,
+                      Grid<double>& world,
+                      double costFn(Loc, Loc, Grid<double>&),
+                      double expectedCost) {
+    if (path.isEmpty() || path[0] != start || path[path.size() - 1] != end) {
+        error("bounded search path errored");
+    }
+    double cost = boundedTestPathCost(path, world, costFn);
+    if (!boundedTestSameCost(cost, expectedCost)) {
+        error("bounded search cost errored");
+    }
+}
+
+// checks the bounded search against A* between two corners of a world, with
+//   an unlimited node limit and with a tight one, which is the given number
+//   of cells, or if that is 0, three quarters of the cells A* stored; then
+//   checks that limits just around the fewest cells any path needs either
+//   find the same cost or are reported as too small, and quickly
+void checkBoundedWorld(Grid<double>& world,
+                       Loc start,
+                       Loc end,
+                       double costFn(Loc, Loc, Grid<double>&),
+                       double heuristic(Loc, Loc, Grid<double>&),
+                       int tightLimit) {
+    // shortestPath colors the cells it visits on the display, so the same A*
+    //   search from MultiGoalSearch is used for the reference instead
+    Vector<Loc> goals;
+    goals += end;
+    boundedTestStored.resize(world.numRows(), world.numCols());
+    boundedTestStored[start.row][start.col] = true;
+    boundedTestNumStored = 1;
+    boundedTestCostFn = costFn;
+    Vector<Loc> reference =
+        shortestPathToAny(start, goals, world, countingCost, heuristic).path;
+    double expectedCost = boundedTestPathCost(reference, world, costFn);
+    if (tightLimit == 0) tightLimit = boundedTestNumStored * 3 / 4;
+
+    int allCells = world.numRows() * world.numCols();
+    Vector<Loc> path = boundedShortestPath(start, end, world, costFn,
+                                           heuristic, allCells);
+    checkBoundedPath(path, start, end, world, costFn, expectedCost);
+    path = boundedShortestPath(start, end, world, costFn, heuristic,
+                               tightLimit);
+    checkBoundedPath(path, start, end, world, costFn, expectedCost);
+
+    // one cell short of the fewest any path needs is rejected up front
+    int minCells = std::max(abs(end.row - start.row),
+                            abs(end.col - start.col)) + 1;
+    bool reported = false;
+    try {
+        boundedShortestPath(start, end, world, costFn, heuristic,
+                            minCells - 1);
+    } catch (ErrorException& ex) {
+        reported = ex.getMessage() == kLimitTooSmall;
+    }
+    if (!reported) error("bounded search limit errored");
+
+    // one cell more than that may fit a path, but leaves almost no room to
+    //   compare it against anything, so the search must give up rather than
+    //   re-expand the same cells without end
+    clock_t began = clock();
+    try {
+        path = boundedShortestPath(start, end, world, costFn, heuristic,
+                                   minCells + 1);
+        checkBoundedPath(path, start, end, world, costFn, expectedCost);
+    } catch (ErrorException& ex) {
+        if (ex.getMessage() != kLimitTooSmall) {
+            error("bounded search limit errored");
+        }
+    }
+    if (clock() - began > 5 * CLOCKS_PER_SEC) {
+        error("bounded search gave up too slowly");
+    }
+}
+
+////////// UNIT TESTS //////////
+void runBoundedSearchUnitTests() {
+    for (int seed = 1; seed <= kBoundedTestWorlds; seed++) {
+        Grid<double> terrain = generateRandomTerrain(33, 33, seed);
+        checkBoundedWorld(terrain, makeLoc(0, 0), makeLoc(32, 32 - 3 * seed),
+                          terrainCost, terrainHeuristic, 0);
+    }
+
+    // a maze has a single way through, so a limit of exactly the path's
+    //   length is the tightest one that still fits it
+    for (int seed = 1; seed <= kBoundedTestWorlds; seed++) {
+        Grid<double> maze = generateRandomMaze(8, 8, KRUSKAL_MAZE, seed);
+        Loc start = makeLoc(0, 0);
+        Loc end = makeLoc(maze.numRows() - 1, maze.numCols() - 1);
+        Vector<Loc> goals;
+        goals += end;
+        int pathCells = shortestPathToAny(start, goals, maze, mazeCost,
+                                          mazeHeuristic).path.size();
+        checkBoundedWorld(maze, start, end, mazeCost, mazeHeuristic,
+                          pathCells);
+    }
+}
+
+#endif
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * File: ConcurrentUnionFind.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of a lock-free UnionFind data structure.
+ * http://en.wikipedia.org/wiki/Disjoint-set_data_structure
+ */
+
+#include "ConcurrentUnionFind.h"
+
+using namespace std;
+
+/*
+ * Every node starts out as its own parent (i.e., as a singleton set).
+ */
+ConcurrentUnionFind::ConcurrentUnionFind(const int numNodes) {
+    // any non-negative int fits in a ConcurrentUnionFindIndex
+    if (numNodes < 0) error("Negative number of nodes");
+    NUM_NODES = numNodes;
+    nodeParents = new ConcurrentUnionFindIndex[NUM_NODES];
+    for (int nodeNum = 0; nodeNum < NUM_NODES; nodeNum++) {
+        nodeParents[nodeNum] = nodeNum;
+    }
+}
+
+/*
+ * Destructor to cleanup the allocated memory.
+ */
+ConcurrentUnionFind::~ConcurrentUnionFind() {
+    delete[] nodeParents;
+}
+
+/*
+ * Find the root node number for a particular node number.
+ */
+int ConcurrentUnionFind::findIndex(const int nodeNum) {
+    checkNodeNum(nodeNum);
+    return findRoot(nodeNum);
+}
+
+/*
+ * Find the roots of both nodes and try to link the one with the smaller
+ *   node number under the other.  The link only succeeds if that root is
+ *   still a root; if another thread has linked it in the meantime, start
+ *   over from the new roots.
+ */
+bool ConcurrentUnionFind::unite(const int a, const int b) {
+    checkNodeNum(a);
+    checkNodeNum(b);
+    int aRoot = a;
+    int bRoot = b;
+    while (true) {
+        aRoot = findRoot(aRoot);
+        bRoot = findRoot(bRoot);
+        if (aRoot == bRoot) return false;
+
+        if (aRoot > bRoot) {
+            int temp = aRoot;
+            aRoot = bRoot;
+            bRoot = temp;
+        }
+        if (__sync_bool_compare_and_swap(&nodeParents[aRoot],
+                                     (ConcurrentUnionFindIndex) aRoot,
+                                     (ConcurrentUnionFindIndex) bRoot)) {
+            return true;
+        }
+    }
+}
+
+/*
+ * If the two roots differ and the first is still a root after the second
+ *   was found, then there was a moment when both were roots at once, so the
+ *   nodes were in different sets.  Otherwise the first root was linked away
+ *   while looking, so look again.
+ */
+bool ConcurrentUnionFind::connected(const int a, const int b) {
+    checkNodeNum(a);
+    checkNodeNum(b);
+    int aRoot = a;
+    int bRoot = b;
+    while (true) {
+        aRoot = findRoot(aRoot);
+        bRoot = findRoot(bRoot);
+        if (aRoot == bRoot) return true;
+        if (nodeParents[aRoot] == ConcurrentUnionFindIndex(aRoot)) {
+            return false;
+        }
+    }
+}
+
+////////// PRIVATE METHODS //////////
+/*
+ * Node numbers index straight into the array, so make sure they are in
+ *   range before using them.
+ */
+void ConcurrentUnionFind::checkNodeNum(const int nodeNum) {
+    if (nodeNum < 0 || nodeNum >= NUM_NODES) error("Array out of bounds");
+}
+
+/*
+ * Walk up to the root, pointing each node visited at its grandparent along
+ *   the way (i.e., path halving).  The grandparent is always further along
+ *   the same path, so this never changes which set a node is in, and if the
+ *   compare-and-swap fails then some other thread has already moved the
+ *   node at least as far.
+ */
+int ConcurrentUnionFind::findRoot(int nodeNum) {
+    while (true) {
+        int parent = nodeParents[nodeNum];
+        if (parent == nodeNum) return nodeNum;
+        int grandparent = nodeParents[parent];
+        if (grandparent != parent) {
+            __sync_bool_compare_and_swap(&nodeParents[nodeNum],
+                                     (ConcurrentUnionFindIndex) parent,
+                                     (ConcurrentUnionFindIndex) grandparent);
+        }
+        nodeNum = grandparent;
+    }
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * File: ConcurrentUnionFind.h
+ *
+ * Eric Beach
+ *
+ * A lock-free UnionFind data structure (i.e., Disjoint-set data structure)
+ *   that many threads can use at once.
+ * http://en.wikipedia.org/wiki/Disjoint-set_data_structure
+ */
+
+#ifndef __Trailblazer__ConcurrentUnionFind__
+#define __Trailblazer__ConcurrentUnionFind__
+
+#include "UnionFind.h"
+
+/*
+ * Type used to store node numbers inside ConcurrentUnionFind.  Unlike
+ *   UnionFindIndex, this is always 32 bits, whether or not
+ *   UNION_FIND_SMALL_INDEX is defined: the structure labels whole worlds at
+ *   once (see Reachability), which can have far more than 65535 cells.
+ */
+typedef unsigned int ConcurrentUnionFindIndex;
+
+/*
+ * A version of UnionFind whose unite, connected and findIndex may be called
+ *   from any number of threads at the same time, on the same structure,
+ *   without locks.  It works only on node numbers (see UnionFind), and every
+ *   node starts out as a singleton set, so there is no makeSet.
+ *
+ * Sets are linked with an atomic compare-and-swap on the parent of a root,
+ *   and always in the same direction: the root with the smaller node number
+ *   becomes a child of the one with the larger.  Parents therefore only ever
+ *   increase along a path, which rules out cycles no matter how operations
+ *   from different threads interleave.  If another thread links a root
+ *   first, the compare-and-swap fails and the operation simply retries from
+ *   the new roots.
+ * Finds never wait on other threads.  They shorten paths as they go (path
+ *   halving) with compare-and-swaps that are allowed to fail, since a failed
+ *   one just means another thread shortened the same path.
+ */
+class ConcurrentUnionFind {
+public:
+    // create a structure holding numNodes singleton sets, numbered 0 to
+    //   numNodes - 1
+    ConcurrentUnionFind(const int numNodes);
+
+    // clean up class by deallocating used memory
+    ~ConcurrentUnionFind();
+
+    // Return the node number of the root of the set containing nodeNum
+    //   at the time of the call
+    int findIndex(const int nodeNum);
+
+    // Join the sets containing nodes a and b; returns true if this call
+    //   merged them and false if they were already in the same set
+    bool unite(const int a, const int b);
+
+    // Return whether nodes a and b are in the same set
+    bool connected(const int a, const int b);
+
+private:
+    // array to store the parent nodes for each node; volatile so that
+    //   every read sees the latest value written by any thread
+    volatile ConcurrentUnionFindIndex* nodeParents;
+
+    // the number of nodes stored
+    int NUM_NODES;
+
+    // report an error if nodeNum is not a valid node number
+    void checkNodeNum(const int nodeNum);
+
+    // find the root of nodeNum, which is assumed to be valid
+    int findRoot(int nodeNum);
+
+    // copying would share nodeParents between two objects, so disallow it
+    ConcurrentUnionFind(const ConcurrentUnionFind& other);
+    ConcurrentUnionFind& operator=(const ConcurrentUnionFind& other);
+};
+
+#endif /* defined(__Trailblazer__ConcurrentUnionFind__) */
@@ -0,0 +1,166 @@
+/******************************************************************************
+ * File: EdgeCostTable.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of precomputed edge costs.
+ */
+
+#include "EdgeCostTable.h"
+#include "Parallel.h"
+#include "error.h"
+#include <cstdlib>
+#include <limits>
+
+using namespace std;
+
+/* Constant: kNumMoves
+ *
+ * The number of moves out of each cell; each cell's costs are stored in the
+ *   order of kMoveRows and kMoveCols.
+ */
+const int kNumMoves = 8;
+static const int kMoveRows[kNumMoves] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+static const int kMoveCols[kNumMoves] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+
+/* Function: moveIndex
+ *
+ * Returns the index, among the moves out of a cell, of the move by
+ *   (drow, dcol), each of which is -1, 0 or 1 but not both 0.
+ */
+static int moveIndex(int drow, int dcol) {
+    int index = (drow + 1) * 3 + (dcol + 1);
+    return index < 4 ? index : index - 1;
+}
+
+/* Function: fillCellCosts
+ *
+ * Works out the costs of the moves out of a cell.
+ */
+static void fillCellCosts(Grid<double>& world,
+                          double costFn(Loc, Loc, Grid<double>&),
+                          int row, int col, double costs[]) {
+    Loc from = makeLoc(row, col);
+    for (int i = 0; i < kNumMoves; i++) {
+        int vRow = row + kMoveRows[i];
+        int vCol = col + kMoveCols[i];
+        if (world.inBounds(vRow, vCol)) {
+            costs[i] = costFn(from, makeLoc(vRow, vCol), world);
+        } else {
+            costs[i] = numeric_limits<double>::infinity();
+        }
+    }
+}
+
+EdgeCostTable::EdgeCostTable() {
+    world = NULL;
+    costFn = NULL;
+    numRows = 0;
+    numCols = 0;
+}
+
+EdgeCostTable::EdgeCostTable(Grid<double>& world,
+                             double costFn(Loc from, Loc to,
+                                           Grid<double>& world)) {
+    build(world, costFn);
+}
+
+/*
+ * State shared by the threads filling in a table.
+ */
+struct EdgeCostState {
+    Grid<double>* world;
+    double (*costFn)(Loc, Loc, Grid<double>&);
+    double* moveCosts;
+};
+
+/*
+ * Fill in the costs of the cells in rows begin to end - 1.  Each thread
+ *   writes only its own rows' part of the table.
+ */
+static void fillRows(int begin, int end, void* data) {
+    EdgeCostState* state = (EdgeCostState*) data;
+    int numCols = state->world->numCols();
+    for (int row = begin; row < end; row++) {
+        for (int col = 0; col < numCols; col++) {
+            fillCellCosts(*state->world, state->costFn, row, col,
+                          state->moveCosts + (row * numCols + col) * kNumMoves);
+        }
+    }
+}
+
+void EdgeCostTable::build(Grid<double>& world,
+                          double costFn(Loc from, Loc to,
+                                        Grid<double>& world)) {
+    this->world = &world;
+    this->costFn = costFn;
+    numRows = world.numRows();
+    numCols = world.numCols();
+    int numCells = numRows * numCols;
+    moveCosts.resize(numCells * kNumMoves);
+    staleCells.assign(numCells, false);
+    if (numCells == 0) return;
+
+    EdgeCostState state;
+    state.world = &world;
+    state.costFn = costFn;
+    state.moveCosts = &moveCosts[0];
+    parallelFor(world.numRows(), fillRows, &state);
+}
+
+/*
+ * A stale cell has all eight of its costs worked out again on the first
+ *   lookup after it was invalidated.
+ */
+double EdgeCostTable::cost(Loc from, Loc to) {
+    if (world == NULL) error("Edge cost table has not been built.");
+    if (from.row < 0 || from.row >= numRows ||
+        from.col < 0 || from.col >= numCols) {
+        error("Edge cost table location is out of range.");
+    }
+    if (from == to) return 0.0;
+
+    int drow = to.row - from.row;
+    int dcol = to.col - from.col;
+    if (abs(drow) > 1 || abs(dcol) > 1) {
+        error("Non-adjacent locations passed into cost function.");
+    }
+
+    int cellNum = from.row * numCols + from.col;
+    if (staleCells[cellNum]) {
+        fillCellCosts(*world, costFn, from.row, from.col,
+                      &moveCosts[cellNum * kNumMoves]);
+        staleCells[cellNum] = false;
+    }
+    return moveCosts[cellNum * kNumMoves + moveIndex(drow, dcol)];
+}
+
+/*
+ * The moves into loc are moves out of its neighbors, so they go stale too.
+ */
+void EdgeCostTable::invalidate(Loc loc) {
+    if (world == NULL) error("Edge cost table has not been built.");
+    for (int row = loc.row - 1; row <= loc.row + 1; row++) {
+        for (int col = loc.col - 1; col <= loc.col + 1; col++) {
+            if (row >= 0 && row < numRows && col >= 0 && col < numCols) {
+                staleCells[row * numCols + col] = true;
+            }
+        }
+    }
+}
+
+bool EdgeCostTable::isBuilt() const {
+    return world != NULL;
+}
+
+/*
+ * swap with empty vectors, since clear alone keeps their capacity.
+ */
+void EdgeCostTable::clear() {
+    world = NULL;
+    costFn = NULL;
+    numRows = 0;
+    numCols = 0;
+    vector<double>().swap(moveCosts);
+    vector<char>().swap(staleCells);
+}
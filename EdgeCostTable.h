@@ -0,0 +1,71 @@
+/******************************************************************************
+ * File: EdgeCostTable.h
+ *
+ * Eric Beach
+ *
+ * Precomputed edge costs for a world that doesn't change between searches.
+ *   Every search calls the cost function for each move it considers (for
+ *   terrainCost, a sqrt, two grid reads and an adjacency check), and
+ *   repeated searches on the same world evaluate the same moves over and
+ *   over.  An EdgeCostTable evaluates each move once and looks it up after
+ *   that.
+ */
+
+#ifndef __Trailblazer__EdgeCostTable__
+#define __Trailblazer__EdgeCostTable__
+
+#include "TrailblazerTypes.h"
+#include "grid.h"
+#include <vector>
+
+/*
+ * The cost of every move from each cell of a world to each of its eight
+ *   neighbors, stored as eight doubles per cell, side by side (so 64 bytes
+ *   per cell).  Moves off the edge of the world cost infinity.
+ * The table is filled in on several threads at once, so the cost function
+ *   must be safe to call concurrently (as terrainCost and mazeCost are).
+ *   When cells of the world change, invalidate them; their costs are
+ *   worked out again the next time they are looked up.
+ */
+class EdgeCostTable {
+public:
+    // create an empty table; every lookup fails until build is called
+    EdgeCostTable();
+
+    // create a table for the given world and cost function
+    EdgeCostTable(Grid<double>& world,
+                  double costFn(Loc from, Loc to, Grid<double>& world));
+
+    // (re)compute every cost of the given world, replacing the table; the
+    //   world must outlive the table, or the next call to build
+    void build(Grid<double>& world,
+               double costFn(Loc from, Loc to, Grid<double>& world));
+
+    // return the cost of moving between two adjacent cells (or 0 for a cell
+    //   and itself), as costFn would
+    double cost(Loc from, Loc to);
+
+    // note that the world's value at loc has changed, which changes the
+    //   cost of every move into or out of it
+    void invalidate(Loc loc);
+
+    // return whether the table has been built (and not cleared since)
+    bool isBuilt() const;
+
+    // release the table's memory; every lookup fails until build is called
+    void clear();
+
+private:
+    Grid<double>* world;
+    double (*costFn)(Loc, Loc, Grid<double>&);
+    int numRows;
+    int numCols;
+
+    // the costs of the moves out of each cell, in row-major order
+    std::vector<double> moveCosts;
+
+    // whether each cell's costs need working out again
+    std::vector<char> staleCells;
+};
+
+#endif /* defined(__Trailblazer__EdgeCostTable__) */
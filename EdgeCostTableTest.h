@@ -0,0 +1,81 @@
+/******************************************************************************
+ * File: EdgeCostTableTest.h
+ *
+ * Eric Beach
+ *
+ * Checks that an EdgeCostTable gives the same costs as the cost function it
+ *   was built from, including after cells of the world change and are
+ *   invalidated.
+ */
+
+#ifndef Trailblazer_EdgeCostTableTest_h
+#define Trailblazer_EdgeCostTableTest_h
+
+#include "EdgeCostTable.h"
+#include "TrailblazerCosts.h"
+#include "error.h"
+
+////////// HELPERS //////////
+// whether the table gives terrainCost's cost for every move in the world
+bool tableMatchesTerrainCost(EdgeCostTable& table, Grid<double>& world) {
+    for (int row = 0; row < world.numRows(); row++) {
+        for (int col = 0; col < world.numCols(); col++) {
+            Loc from = makeLoc(row, col);
+            for (int dRow = -1; dRow <= 1; dRow++) {
+                for (int dCol = -1; dCol <= 1; dCol++) {
+                    if (!world.inBounds(row + dRow, col + dCol)) continue;
+                    Loc to = makeLoc(row + dRow, col + dCol);
+                    if (table.cost(from, to) != terrainCost(from, to, world)) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+////////// UNIT TESTS //////////
+void runEdgeCostTableUnitTests() {
+    // a small hand-made terrain, so the test doesn't depend on the generator
+    Grid<double> world(5, 6);
+    for (int row = 0; row < world.numRows(); row++) {
+        for (int col = 0; col < world.numCols(); col++) {
+            world[row][col] = ((row * 7 + col * 3) % 10) / 10.0;
+        }
+    }
+
+    EdgeCostTable table;
+    if (table.isBuilt()) error("edge cost table errored");
+    table.build(world, terrainCost);
+    if (!table.isBuilt()) error("edge cost table build errored");
+    if (!tableMatchesTerrainCost(table, world)) {
+        error("edge cost table build errored");
+    }
+
+    // once a cell changes, the table is out of date until it is invalidated;
+    //   the corner cell checks that invalidating at the edge stays in bounds
+    Loc middle = makeLoc(2, 3);
+    Loc corner = makeLoc(4, 5);
+    world[middle.row][middle.col] = 0.95;
+    world[corner.row][corner.col] = 0.05;
+    if (tableMatchesTerrainCost(table, world)) {
+        error("edge cost table errored");
+    }
+    table.invalidate(middle);
+    table.invalidate(corner);
+    if (!tableMatchesTerrainCost(table, world)) {
+        error("edge cost table invalidate errored");
+    }
+
+    // a cleared table is rebuilt from scratch
+    table.clear();
+    if (table.isBuilt()) error("edge cost table clear errored");
+    world[0][0] = 0.5;
+    table.build(world, terrainCost);
+    if (!tableMatchesTerrainCost(table, world)) {
+        error("edge cost table build errored");
+    }
+}
+
+#endif
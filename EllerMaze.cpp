@@ -0,0 +1,183 @@
+/******************************************************************************
+ * File: EllerMaze.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of Eller's algorithm for streaming maze generation.
+ */
+
+#include "EllerMaze.h"
+#include "error.h"
+#include <string>
+
+using namespace std;
+
+/* Constants: kFloorText, kWallText
+ *
+ * How kMazeFloor and kMazeWall are written in a world file.
+ */
+const char kFloorText = '1';
+const char kWallText = '0';
+
+/*
+ * The state writeEllerMaze threads through to writeMazeRow.
+ */
+struct MazeFileState {
+    ostream* out;
+    int numRows;
+
+    // the text of one row of the world, reused from row to row
+    string line;
+};
+
+/* Function: findColumnSet
+ *
+ * The cells of the current row are kept in a union-find over their columns:
+ *   sets[col] leads, eventually, to the column that represents the set the
+ *   cell is in.  Return that column, halving the path on the way.
+ */
+static int findColumnSet(vector<int>& sets, int col) {
+    while (sets[col] != col) {
+        sets[col] = sets[sets[col]];
+        col = sets[col];
+    }
+    return col;
+}
+
+void generateEllerMaze(int numRows, int numCols,
+                       void consumer(const MazeRow& row, void* data),
+                       void* data) {
+    FastRandom random;
+    generateEllerMaze(numRows, numCols, consumer, data, random);
+}
+
+/*
+ * Two cells are in the same set when the rows so far already connect them.
+ *   Each row joins some neighbors that are in different sets, then sends at
+ *   least one passage down from every set so that none is cut off; the last
+ *   row joins every pair of neighbors still in different sets, which
+ *   connects the whole maze without ever making a loop.
+ */
+void generateEllerMaze(int numRows, int numCols,
+                       void consumer(const MazeRow& row, void* data),
+                       void* data, FastRandom& random) {
+    if (numRows < 0 || numCols < 0) error("Maze size must not be negative.");
+    if (numRows == 0 || numCols == 0) return;
+
+    MazeRow curr;
+    curr.rightPassages.assign(numCols, false);
+    curr.downPassages.assign(numCols, false);
+
+    // every cell of the first row starts out in a set of its own
+    vector<int> sets(numCols);
+    for (int col = 0; col < numCols; col++) {
+        sets[col] = col;
+    }
+
+    // indexed by the column that represents a set: the number of its cells
+    //   not yet given a chance to go down, and the column of its first
+    //   down passage (or -1 if it hasn't got one yet)
+    vector<int> cellsLeft(numCols);
+    vector<int> firstDown(numCols);
+
+    for (int row = 0; row < numRows; row++) {
+        bool lastRow = row == numRows - 1;
+        curr.row = row;
+
+        // STEP 1: Join neighbors that are in different sets, at random
+        //         (or always, in the last row)
+        for (int col = 0; col < numCols - 1; col++) {
+            int leftSet = findColumnSet(sets, col);
+            int rightSet = findColumnSet(sets, col + 1);
+            bool join = leftSet != rightSet &&
+                        (lastRow || (random.nextBits() & 1));
+            curr.rightPassages[col] = join;
+            if (join) sets[rightSet] = leftSet;
+        }
+
+        if (lastRow) {
+            curr.downPassages.assign(numCols, false);
+            consumer(curr, data);
+            break;
+        }
+
+        // STEP 2: Open passages down at random, forcing one at the last
+        //         cell of any set that would otherwise have none
+        for (int col = 0; col < numCols; col++) {
+            sets[col] = findColumnSet(sets, col);
+            cellsLeft[col] = 0;
+            firstDown[col] = -1;
+        }
+        for (int col = 0; col < numCols; col++) {
+            cellsLeft[sets[col]]++;
+        }
+        for (int col = 0; col < numCols; col++) {
+            int set = sets[col];
+            cellsLeft[set]--;
+            bool down = (random.nextBits() & 1) ||
+                        (cellsLeft[set] == 0 && firstDown[set] == -1);
+            curr.downPassages[col] = down;
+            if (down && firstDown[set] == -1) firstDown[set] = col;
+        }
+        consumer(curr, data);
+
+        // STEP 3: Set up the next row; a cell below a passage down stays in
+        //         the set above it, and any other cell starts a new set
+        for (int col = 0; col < numCols; col++) {
+            sets[col] = curr.downPassages[col] ? firstDown[sets[col]] : col;
+        }
+    }
+}
+
+/* Function: writeMazeRow
+ *
+ * Write one row of cells as two rows of the world: the cells and the
+ *   passages between them, then (except after the last row) the passages
+ *   down to the next row.
+ */
+static void writeMazeRow(const MazeRow& row, void* data) {
+    MazeFileState* state = (MazeFileState*) data;
+    int numCols = int(row.rightPassages.size());
+    string& line = state->line;
+
+    line.clear();
+    for (int col = 0; col < numCols; col++) {
+        line += kFloorText;
+        line += ' ';
+        if (col < numCols - 1) {
+            line += row.rightPassages[col] ? kFloorText : kWallText;
+            line += ' ';
+        }
+    }
+    line += '\n';
+
+    if (row.row < state->numRows - 1) {
+        for (int col = 0; col < numCols; col++) {
+            line += row.downPassages[col] ? kFloorText : kWallText;
+            line += ' ';
+            if (col < numCols - 1) {
+                line += kWallText;
+                line += ' ';
+            }
+        }
+        line += '\n';
+    }
+    state->out->write(line.data(), line.size());
+}
+
+void writeEllerMaze(ostream& out, int numRows, int numCols) {
+    FastRandom random;
+    writeEllerMaze(out, numRows, numCols, random);
+}
+
+void writeEllerMaze(ostream& out, int numRows, int numCols,
+                    FastRandom& random) {
+    if (numRows <= 0 || numCols <= 0) error("Maze size must be positive.");
+    out << "maze" << endl;
+    out << 2 * numRows - 1 << " " << 2 * numCols - 1 << endl;
+
+    MazeFileState state;
+    state.out = &out;
+    state.numRows = numRows;
+    generateEllerMaze(numRows, numCols, writeMazeRow, &state, random);
+}
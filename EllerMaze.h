@@ -0,0 +1,64 @@
+/******************************************************************************
+ * File: EllerMaze.h
+ *
+ * Eric Beach
+ *
+ * Maze generation via Eller's algorithm, which builds a maze one row at a
+ *   time and only ever remembers the row it is working on.  The rows are
+ *   handed to a consumer as they are finished, so a maze of any number of
+ *   rows can be streamed to a world file (or anywhere else) without ever
+ *   being held in memory as a whole.
+ *
+ * Credits:
+ *  http://www.neocomputer.org/projects/eller.html
+ *  http://weblog.jamisbuck.org/2010/12/29/maze-generation-eller-s-algorithm
+ */
+
+#ifndef __Trailblazer__EllerMaze__
+#define __Trailblazer__EllerMaze__
+
+#include "FastRandom.h"
+#include <iostream>
+#include <vector>
+
+/*
+ * One finished row of cells of a maze.  rightPassages[col] says whether
+ *   (row, col) has a passage to (row, col + 1), and downPassages[col]
+ *   whether it has one to (row + 1, col); both have one entry per column.
+ *   The last column never has a right passage and the last row never has
+ *   a down passage.
+ */
+struct MazeRow {
+    int row;
+    std::vector<char> rightPassages;
+    std::vector<char> downPassages;
+};
+
+/* Function: generateEllerMaze
+ *
+ * Generates a numRows x numCols maze with Eller's algorithm, calling
+ *   consumer(row, data) once for each row, top to bottom, as soon as that
+ *   row is finished.  data is passed through unchanged.  Uses O(numCols)
+ *   memory however many rows there are.
+ * The version that takes a FastRandom draws all of its random numbers from
+ *   it, so a seeded generator gives the same maze every time.
+ */
+void generateEllerMaze(int numRows, int numCols,
+                       void consumer(const MazeRow& row, void* data),
+                       void* data);
+void generateEllerMaze(int numRows, int numCols,
+                       void consumer(const MazeRow& row, void* data),
+                       void* data, FastRandom& random);
+
+/* Function: writeEllerMaze
+ *
+ * Generates a numRows x numCols maze with Eller's algorithm and writes it to
+ *   out as a maze world file (a (2 * numRows - 1) x (2 * numCols - 1) grid
+ *   of walls and floors, as generateRandomMaze would lay it out), one row
+ *   at a time.
+ */
+void writeEllerMaze(std::ostream& out, int numRows, int numCols);
+void writeEllerMaze(std::ostream& out, int numRows, int numCols,
+                    FastRandom& random);
+
+#endif /* defined(__Trailblazer__EllerMaze__) */
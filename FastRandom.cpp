@@ -0,0 +1,80 @@
+/******************************************************************************
+ * File: FastRandom.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of the PCG32 pseudo-random number generator.
+ * http://www.pcg-random.org/
+ */
+
+#include "FastRandom.h"
+#include "random.h"
+#include "error.h"
+
+using namespace std;
+
+/* Constant: kPcgMultiplier
+ *
+ * Multiplier of the underlying 64-bit linear congruential generator.
+ */
+const uint64_t kPcgMultiplier = 6364136223846793005ULL;
+
+FastRandom::FastRandom() {
+    // randomInteger only gives out 31 bits at a time
+    uint64_t high = (uint64_t) randomInteger(0, 0x7FFFFFFF);
+    uint64_t low = (uint64_t) randomInteger(0, 0x7FFFFFFF);
+    seed((high << 31) ^ low, 0);
+}
+
+FastRandom::FastRandom(uint64_t seed, uint64_t stream) {
+    this->seed(seed, stream);
+}
+
+/*
+ * The increment must be odd; each stream gets a different one.
+ */
+void FastRandom::seed(uint64_t seed, uint64_t stream) {
+    state = 0;
+    increment = (stream << 1) | 1;
+    nextBits();
+    state += seed;
+    nextBits();
+}
+
+/*
+ * Advance the linear congruential generator, then scramble the old state
+ *   with a xorshift and a state-dependent rotation.
+ */
+uint32_t FastRandom::nextBits() {
+    uint64_t oldState = state;
+    state = oldState * kPcgMultiplier + increment;
+    uint32_t xorShifted = (uint32_t) (((oldState >> 18) ^ oldState) >> 27);
+    uint32_t rotation = (uint32_t) (oldState >> 59);
+    return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+}
+
+/*
+ * Scale 32 random bits into [0, bound) with a multiply and a shift, which
+ *   avoids the division in a modulo.  The bias this leaves is at most
+ *   bound / 2^32, far too small to matter for world generation.
+ */
+int FastRandom::nextInt(int bound) {
+    if (bound <= 0) error("FastRandom::nextInt needs a positive bound.");
+    return (int) (((uint64_t) nextBits() * (uint64_t) bound) >> 32);
+}
+
+double FastRandom::nextReal() {
+    return nextBits() * (1.0 / 4294967296.0);
+}
+
+/*
+ * Add the golden-ratio increment SplitMix64 steps by, then mix with two
+ *   xorshift-multiply rounds.
+ * http://xoshiro.di.unimi.it/splitmix64.c
+ */
+uint64_t hashBits(uint64_t key) {
+    uint64_t z = key + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+ * File: FastRandom.h
+ *
+ * Eric Beach
+ *
+ * A small, fast, seedable pseudo-random number generator (PCG32) for the
+ *   hot loops of world generation, where calling randomReal / randomInteger
+ *   once per edge or per cell dominates the running time.
+ * http://www.pcg-random.org/
+ */
+
+#ifndef __Trailblazer__FastRandom__
+#define __Trailblazer__FastRandom__
+
+#include <stdint.h>
+
+/*
+ * A PCG32 generator: 64 bits of state, 32 bits of output per step.  Two
+ *   generators built from the same seed produce the same sequence, on any
+ *   machine, which makes generated worlds reproducible.
+ */
+class FastRandom {
+public:
+    // seed from the Stanford library's generator, so that setRandomSeed
+    //   still makes everything that uses FastRandom reproducible
+    FastRandom();
+
+    // seed explicitly; stream picks one of 2^63 independent sequences for
+    //   the same seed (e.g., one per thread or per tile)
+    FastRandom(uint64_t seed, uint64_t stream = 0);
+
+    // return the next 32 random bits
+    uint32_t nextBits();
+
+    // return a random integer in the range [0, bound); bound must be
+    //   positive
+    int nextInt(int bound);
+
+    // return a random real number in the range [0, 1)
+    double nextReal();
+
+private:
+    uint64_t state;
+    uint64_t increment;
+
+    // set up state and increment from a seed and stream
+    void seed(uint64_t seed, uint64_t stream);
+};
+
+/* Function: hashBits
+ *
+ * Returns 64 random-looking bits that depend only on key (the finalizer of
+ *   SplitMix64).  Where a generator hands out numbers in sequence, this
+ *   gives the random number for a particular key, e.g., one per cell of a
+ *   grid, so the numbers come out the same whatever order the cells are
+ *   visited in and however the work is split between threads.
+ */
+uint64_t hashBits(uint64_t key);
+
+#endif /* defined(__Trailblazer__FastRandom__) */
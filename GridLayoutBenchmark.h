@@ -0,0 +1,225 @@
+/******************************************************************************
+ * File: GridLayoutBenchmark.h
+ *
+ * Eric Beach
+ *
+ * Benchmarks comparing the row-major layout of Grid with the tiled layout of
+ *   TiledGrid, on the access patterns that matter most here: A* search
+ *   expanding cells 8 neighbors at a time, walks down columns (as long
+ *   vertical moves make), and a separable blur like the one smoothTerrain
+ *   runs.  Values are floats so that the 16384 x 16384 run
+ *   fits in a few gigabytes.  These take minutes at the largest size, so
+ *   they aren't run on every launch; build with -DRUN_GRID_LAYOUT_BENCHMARKS
+ *   (e.g., in the target's Preprocessor Macros, with optimization on) to run
+ *   them at startup, after the unit tests.  Each benchmark prints its time
+ *   for both layouts to the console before the window takes any input.
+ */
+
+#ifndef Trailblazer_GridLayoutBenchmark_h
+#define Trailblazer_GridLayoutBenchmark_h
+
+#include "grid.h"
+#include "TiledGrid.h"
+#include "FastRandom.h"
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <vector>
+
+////////// HELPERS //////////
+// sizes (rows and columns) to benchmark
+const int kLayoutBenchmarkSizes[] = { 1024, 4096, 16384 };
+const int kNumLayoutBenchmarkSizes = 3;
+
+// number of cells each A* benchmark expands
+const int kBenchmarkExpansions = 2000000;
+
+// blur kernel radius, about that of smoothTerrain
+const int kBenchmarkBlurRadius = 9;
+
+// seconds elapsed since start
+double benchmarkSeconds(clock_t start) {
+    return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// fill a grid with heights in [0, 1]: long, gentle slopes plus a little
+//   per-cell noise, so that A* wanders rather than running straight
+template <typename GridType>
+void fillBenchmarkHeights(GridType& heights) {
+    for (int row = 0; row < heights.numRows(); row++) {
+        for (int col = 0; col < heights.numCols(); col++) {
+            uint64_t bits = hashBits((uint64_t(row) << 32) | uint32_t(col));
+            double noise = double(bits >> 11) / 9007199254740992.0;
+            heights.unchecked(row, col) = float(0.4 + 0.25 * sin(row * 0.003) *
+                                                cos(col * 0.004) +
+                                                0.1 * noise);
+        }
+    }
+}
+
+// a cell waiting to be expanded by the benchmark search
+struct BenchmarkEntry {
+    float estimate;
+    float cost;
+    int row;
+    int col;
+
+    bool operator<(const BenchmarkEntry& other) const {
+        return estimate > other.estimate;
+    }
+};
+
+// run A* with terrainCost's costs from the top middle of the grid toward
+//   the bottom middle (so that it mostly moves down columns), stopping after
+//   kBenchmarkExpansions cells; bestCosts must hold +infinity everywhere.
+//   Returns the total cost of the expanded cells, which should not depend
+//   on the layout.
+template <typename GridType>
+double benchmarkExpansions(GridType& heights, GridType& bestCosts) {
+    const float kPenalty = 100.0f;
+    int numRows = heights.numRows();
+    int numCols = heights.numCols();
+    int endRow = numRows - 1;
+    int endCol = numCols / 2;
+
+    std::priority_queue<BenchmarkEntry> queue;
+    BenchmarkEntry first = { float(endRow), 0.0f, 0, numCols / 2 };
+    bestCosts.unchecked(first.row, first.col) = 0.0f;
+    queue.push(first);
+
+    double total = 0.0;
+    int expanded = 0;
+    while (!queue.empty() && expanded < kBenchmarkExpansions) {
+        BenchmarkEntry curr = queue.top();
+        queue.pop();
+        if (curr.cost > bestCosts.unchecked(curr.row, curr.col)) continue;
+        expanded++;
+        total += curr.cost;
+        float currHeight = heights.unchecked(curr.row, curr.col);
+
+        for (int row = curr.row - 1; row <= curr.row + 1; row++) {
+            for (int col = curr.col - 1; col <= curr.col + 1; col++) {
+                if (row < 0 || row >= numRows || col < 0 || col >= numCols ||
+                    (row == curr.row && col == curr.col)) continue;
+                float step = (row != curr.row && col != curr.col) ?
+                             1.41421356f : 1.0f;
+                float height = heights.unchecked(row, col);
+                float cost = curr.cost + step +
+                             kPenalty * fabs(height - currHeight);
+                float& best = bestCosts.unchecked(row, col);
+                if (cost >= best) continue;
+                best = cost;
+                int drow = endRow - row;
+                int dcol = endCol - col;
+                BenchmarkEntry next = {
+                    cost + float(sqrt(double(drow * drow + dcol * dcol))),
+                    cost, row, col
+                };
+                queue.push(next);
+            }
+        }
+    }
+    return total;
+}
+
+// blur a grid along rows into buffer, then along columns back into the
+//   grid, reading and writing one cell at a time through unchecked
+template <typename GridType>
+void benchmarkBlur(GridType& values, GridType& buffer) {
+    float weights[2 * kBenchmarkBlurRadius + 1];
+    float totalWeight = 0.0f;
+    for (int a = -kBenchmarkBlurRadius; a <= kBenchmarkBlurRadius; a++) {
+        weights[a + kBenchmarkBlurRadius] = float(exp(-a * a / 18.0));
+        totalWeight += weights[a + kBenchmarkBlurRadius];
+    }
+    int numRows = values.numRows();
+    int numCols = values.numCols();
+    for (int row = 0; row < numRows; row++) {
+        for (int col = 0; col < numCols; col++) {
+            float sum = 0.0f;
+            for (int a = -kBenchmarkBlurRadius; a <= kBenchmarkBlurRadius;
+                 a++) {
+                int sampleCol = std::min(std::max(col + a, 0), numCols - 1);
+                sum += weights[a + kBenchmarkBlurRadius] *
+                       values.unchecked(row, sampleCol);
+            }
+            buffer.unchecked(row, col) = sum / totalWeight;
+        }
+    }
+    for (int row = 0; row < numRows; row++) {
+        for (int col = 0; col < numCols; col++) {
+            float sum = 0.0f;
+            for (int a = -kBenchmarkBlurRadius; a <= kBenchmarkBlurRadius;
+                 a++) {
+                int sampleRow = std::min(std::max(row + a, 0), numRows - 1);
+                sum += weights[a + kBenchmarkBlurRadius] *
+                       buffer.unchecked(sampleRow, col);
+            }
+            values.unchecked(row, col) = sum / totalWeight;
+        }
+    }
+}
+
+// walk down every column in turn, as a long vertical move does, returning
+//   the total climb
+template <typename GridType>
+double benchmarkColumnWalk(GridType& heights) {
+    double climb = 0.0;
+    for (int col = 0; col < heights.numCols(); col++) {
+        for (int row = 1; row < heights.numRows(); row++) {
+            climb += fabs(heights.unchecked(row, col) -
+                          heights.unchecked(row - 1, col));
+        }
+    }
+    return climb;
+}
+
+// time the benchmarks on one layout of one size, printing the
+//   results; the grids are freed before returning
+template <typename GridType>
+void benchmarkLayout(const char* name, int size) {
+    GridType heights(size, size);
+    fillBenchmarkHeights(heights);
+
+    GridType scratch(size, size);
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            scratch.unchecked(row, col) =
+                std::numeric_limits<float>::infinity();
+        }
+    }
+    clock_t start = clock();
+    double total = benchmarkExpansions(heights, scratch);
+    double searchTime = benchmarkSeconds(start);
+
+    start = clock();
+    total += benchmarkColumnWalk(heights);
+    double walkTime = benchmarkSeconds(start);
+
+    start = clock();
+    benchmarkBlur(heights, scratch);
+    double blurTime = benchmarkSeconds(start);
+
+    std::cout << std::setw(6) << size << " " << std::setw(10) << name
+              << "  A*: " << std::fixed << std::setprecision(3)
+              << searchTime << " s  column walk: " << walkTime
+              << " s  blur: " << blurTime << " s"
+              << "  (check " << std::setprecision(0) << total << ")"
+              << std::endl;
+}
+
+////////// BENCHMARKS //////////
+void runGridLayoutBenchmarks() {
+    std::cout << "Grid layout benchmarks (" << kBenchmarkExpansions
+              << " A* expansions, blur radius " << kBenchmarkBlurRadius
+              << ")" << std::endl;
+    for (int i = 0; i < kNumLayoutBenchmarkSizes; i++) {
+        benchmarkLayout<Grid<float> >("row-major", kLayoutBenchmarkSizes[i]);
+        benchmarkLayout<TiledGrid<float> >("tiled", kLayoutBenchmarkSizes[i]);
+    }
+}
+
+#endif
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * File: GridSearch.h
+ *
+ * Eric Beach
+ *
+ * The A* search shared by the searches that keep only one byte of state per
+ *   cell: shortestMazePath, shortestTerrainPath and both passes of
+ *   coarseToFinePath.  Each byte records how its cell was reached, so the
+ *   search needs no parent links, cost tables or decrease-key; the searches
+ *   differ only in where those bytes live and in what each step costs,
+ *   which they supply as the Marks and Moves types of gridAStar.
+ */
+
+#ifndef __Trailblazer__GridSearch__
+#define __Trailblazer__GridSearch__
+
+#include "TrailblazerTypes.h"
+#include "vector.h"
+#include "error.h"
+#include <limits>
+#include <queue>
+#include <vector>
+
+/* Constants: kGridRowSteps, kGridColSteps, kGridDiagonalSteps
+ *
+ * The eight steps from a cell to its neighbors, and which of them are
+ *   diagonal.
+ */
+const int kNumGridSteps = 8;
+static const int kGridRowSteps[kNumGridSteps] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+static const int kGridColSteps[kNumGridSteps] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+static const bool kGridDiagonalSteps[kNumGridSteps] = {
+    true, false, true, false, false, true, false, true
+};
+
+/* Constants: kUnvisitedCell, kStartCell
+ *
+ * Marks for a cell that hasn't been visited yet and for the start cell.
+ *   Every other visited cell is marked with 1 + the step (an index into
+ *   kGridRowSteps and kGridColSteps) that reached it.
+ */
+const unsigned char kUnvisitedCell = 0;
+const unsigned char kStartCell = kNumGridSteps + 1;
+
+/*
+ * Marks for every cell of a numRows x numCols grid, stored row by row.
+ */
+class GridMarks {
+public:
+    GridMarks(int numRows, int numCols)
+        : rows(numRows), cols(numCols),
+          marks(numRows * numCols, kUnvisitedCell) {}
+
+    // return the mark of a cell, or NULL if it is outside the grid
+    unsigned char* mark(Loc loc) {
+        if (loc.row < 0 || loc.row >= rows || loc.col < 0 || loc.col >= cols) {
+            return NULL;
+        }
+        return &marks[loc.row * cols + loc.col];
+    }
+
+private:
+    int rows;
+    int cols;
+    std::vector<unsigned char> marks;
+};
+
+/*
+ * A cell waiting to be visited.  Cells are not updated in place when a
+ *   cheaper way to them turns up; each way gets its own entry, and entries
+ *   for cells that have already been visited are skipped.  The entry is
+ *   kept to 24 bytes, since the queue moves entries around a great deal.
+ */
+struct GridQueueEntry {
+    double estimate;
+    double cost;
+    Loc loc;
+    unsigned char mark;
+};
+
+/*
+ * Orders the queue by estimated total cost, breaking ties in favor of the
+ *   cell furthest from the start (i.e., closest to the end).
+ */
+struct LaterGridEntry {
+    bool operator()(const GridQueueEntry& a, const GridQueueEntry& b) const {
+        if (a.estimate != b.estimate) return a.estimate > b.estimate;
+        return a.cost < b.cost;
+    }
+};
+
+/* Function: gridAStar
+ *
+ * Finds the cheapest path from start to end with A* search, stepping from a
+ *   cell to any of its eight neighbors (or only the four beside it), and
+ *   returns the cells to visit in order.  Marks holds a mark for every
+ *   cell the search may use, all kUnvisitedCell to begin with:
+ *
+ *     unsigned char* mark(Loc loc)    the cell's mark, or NULL if the search
+ *                                     may not use the cell
+ *
+ *   and Moves says which steps can be taken and what they cost:
+ *
+ *     static const bool kDiagonalSteps
+ *                                     whether the search steps diagonally
+ *     double cost(Loc from, Loc to)   the cost of a step between two cells
+ *                                     the search may use, or infinity if it
+ *                                     can't be taken
+ *     double heuristic(Loc loc)       a consistent estimate of the cost
+ *                                     from loc to end
+ *
+ * Since the heuristic is consistent, the first entry for a cell to come out
+ *   of the queue is the cheapest, so each cell is visited just once.
+ * If no path is found, this function reports an error.
+ */
+template <typename Marks, typename Moves>
+Vector<Loc> gridAStar(Loc start, Loc end, Marks& marks, Moves& moves) {
+    std::priority_queue<GridQueueEntry, std::vector<GridQueueEntry>,
+                        LaterGridEntry> queue;
+
+    GridQueueEntry first;
+    first.estimate = moves.heuristic(start);
+    first.cost = 0.0;
+    first.loc = start;
+    first.mark = kStartCell;
+    queue.push(first);
+
+    while (true) {
+        if (queue.empty()) {
+            error("No path exists between the start and end locations.");
+        }
+        GridQueueEntry curr = queue.top();
+        queue.pop();
+
+        unsigned char* mark = marks.mark(curr.loc);
+        if (*mark != kUnvisitedCell) continue;
+        *mark = curr.mark;
+        if (curr.loc == end) break;
+
+        for (int step = 0; step < kNumGridSteps; step++) {
+            if (!Moves::kDiagonalSteps && kGridDiagonalSteps[step]) continue;
+            Loc v = makeLoc(curr.loc.row + kGridRowSteps[step],
+                            curr.loc.col + kGridColSteps[step]);
+            unsigned char* vMark = marks.mark(v);
+            if (vMark == NULL || *vMark != kUnvisitedCell) continue;
+            double stepCost = moves.cost(curr.loc, v);
+            if (stepCost == std::numeric_limits<double>::infinity()) continue;
+            GridQueueEntry next;
+            next.cost = curr.cost + stepCost;
+            next.estimate = next.cost + moves.heuristic(v);
+            next.loc = v;
+            next.mark = (unsigned char) (step + 1);
+            queue.push(next);
+        }
+    }
+
+    // trace back from the end, then put the path in order
+    Vector<Loc> reversePath;
+    Loc curr = end;
+    while (true) {
+        reversePath += curr;
+        unsigned char mark = *marks.mark(curr);
+        if (mark == kStartCell) break;
+        curr.row -= kGridRowSteps[mark - 1];
+        curr.col -= kGridColSteps[mark - 1];
+    }
+    Vector<Loc> path;
+    for (int i = reversePath.size() - 1; i >= 0; i--) {
+        path += reversePath[i];
+    }
+    return path;
+}
+
+#endif /* defined(__Trailblazer__GridSearch__) */
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * File: Heightfield.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of a compact terrain heightfield.
+ */
+
+#include "Heightfield.h"
+#include "error.h"
+
+using namespace std;
+
+/* Constant: kQuantizedMax
+ *
+ * The stored value of a quantized height of 1.0.
+ */
+const double kQuantizedMax = 65535.0;
+
+Heightfield::Heightfield() {
+    rows = 0;
+    cols = 0;
+    storage = FLOAT_HEIGHTS;
+}
+
+Heightfield::Heightfield(int numRows, int numCols, HeightPrecision precision) {
+    if (numRows < 0 || numCols < 0) {
+        error("Heightfield size must not be negative.");
+    }
+    rows = numRows;
+    cols = numCols;
+    storage = precision;
+    if (precision == FLOAT_HEIGHTS) {
+        floatHeights.assign(numRows * numCols, 0.0f);
+    } else {
+        quantizedHeights.assign(numRows * numCols, 0);
+    }
+}
+
+Heightfield::Heightfield(Grid<double>& world, HeightPrecision precision) {
+    rows = world.numRows();
+    cols = world.numCols();
+    storage = precision;
+    if (precision == FLOAT_HEIGHTS) {
+        floatHeights.resize(rows * cols);
+    } else {
+        quantizedHeights.resize(rows * cols);
+    }
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            set(row, col, world[row][col]);
+        }
+    }
+}
+
+int Heightfield::numRows() const {
+    return rows;
+}
+
+int Heightfield::numCols() const {
+    return cols;
+}
+
+HeightPrecision Heightfield::precision() const {
+    return storage;
+}
+
+bool Heightfield::inBounds(int row, int col) const {
+    return row >= 0 && row < rows && col >= 0 && col < cols;
+}
+
+double Heightfield::get(int row, int col) const {
+    int index = cellIndex(row, col);
+    if (storage == FLOAT_HEIGHTS) return floatHeights[index];
+    return quantizedHeights[index] / kQuantizedMax;
+}
+
+/*
+ * Quantized heights are rounded to the nearest step.
+ */
+void Heightfield::set(int row, int col, double height) {
+    int index = cellIndex(row, col);
+    if (storage == FLOAT_HEIGHTS) {
+        floatHeights[index] = float(height);
+    } else {
+        if (!(height >= 0.0 && height <= 1.0)) {
+            error("Quantized heights must be in the range [0, 1].");
+        }
+        quantizedHeights[index] = uint16_t(height * kQuantizedMax + 0.5);
+    }
+}
+
+Grid<double> Heightfield::toGrid() const {
+    Grid<double> result(rows, cols);
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            result[row][col] = get(row, col);
+        }
+    }
+    return result;
+}
+
+////////// PRIVATE METHODS //////////
+int Heightfield::cellIndex(int row, int col) const {
+    if (!inBounds(row, col)) error("Heightfield location is out of range.");
+    return row * cols + col;
+}
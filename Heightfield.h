@@ -0,0 +1,78 @@
+/******************************************************************************
+ * File: Heightfield.h
+ *
+ * Eric Beach
+ *
+ * A compact store for terrain heights.  Terrain heights all lie in [0, 1] and
+ *   the terrain files only carry about six significant digits, so the eight
+ *   bytes a Grid<double> spends on each cell are mostly wasted; a
+ *   Heightfield spends four (a float) or two (a 16-bit fixed-point height).
+ */
+
+#ifndef __Trailblazer__Heightfield__
+#define __Trailblazer__Heightfield__
+
+#include "TrailblazerTypes.h"
+#include "grid.h"
+#include <stdint.h>
+#include <vector>
+
+/* Type: HeightPrecision
+ *
+ * How a Heightfield stores each height.
+ *
+ * FLOAT_HEIGHTS keeps a float: any height, to about seven significant digits
+ *   (within 2^-24 relative of the height it was given).
+ * QUANTIZED_HEIGHTS keeps the nearest multiple of 1 / 65535 to the height,
+ *   which must be in [0, 1]: within 1 / 131070 of the height it was given.
+ *
+ * Either way, terrainCost and terrainHeuristic work out every cost in double
+ *   precision from the heights as stored, so a search over a Heightfield is
+ *   exact for those heights, and its heuristic is still admissible.  The
+ *   cost of a move differs from the cost over the original Grid<double> by
+ *   at most kAltitudePenalty (100) times the error in the two heights:
+ *   about 1.5e-3 for quantized heights, and far less for floats.
+ */
+enum HeightPrecision { FLOAT_HEIGHTS, QUANTIZED_HEIGHTS };
+
+/*
+ * A numRows x numCols grid of terrain heights, stored at the given precision.
+ */
+class Heightfield {
+public:
+    // create an empty heightfield, or one whose heights are all 0
+    Heightfield();
+    Heightfield(int numRows, int numCols, HeightPrecision precision);
+
+    // create a heightfield holding the heights of a terrain world
+    Heightfield(Grid<double>& world, HeightPrecision precision);
+
+    int numRows() const;
+    int numCols() const;
+    HeightPrecision precision() const;
+
+    // return whether (row, col) is inside the heightfield
+    bool inBounds(int row, int col) const;
+
+    // return / change the height at (row, col), which must be in bounds
+    double get(int row, int col) const;
+    void set(int row, int col, double height);
+
+    // return the heights as a terrain world (e.g., to display it)
+    Grid<double> toGrid() const;
+
+private:
+    int rows;
+    int cols;
+    HeightPrecision storage;
+
+    // the heights in row-major order; only the vector matching the
+    //   precision is used
+    std::vector<float> floatHeights;
+    std::vector<uint16_t> quantizedHeights;
+
+    // return the index of (row, col) in the vectors, checking bounds
+    int cellIndex(int row, int col) const;
+};
+
+#endif /* defined(__Trailblazer__Heightfield__) */
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * File: MazeSearch.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of shortest path search on a PackedMaze.
+ */
+
+#include "MazeSearch.h"
+#include "GridSearch.h"
+#include "TrailblazerConstants.h"
+#include "error.h"
+#include <cstdlib>
+
+using namespace std;
+
+/*
+ * The costs of a maze search's steps, which are never diagonal: 1 through a
+ *   passage and infinite anywhere else, with the Manhattan distance to the
+ *   end as the heuristic, which is never more than the length of a path.
+ */
+struct MazeMoves {
+    static const bool kDiagonalSteps = false;
+
+    const PackedMaze& maze;
+    Loc end;
+
+    MazeMoves(const PackedMaze& maze, Loc end) : maze(maze), end(end) {}
+
+    double cost(Loc from, Loc to) {
+        return maze.passageCost(from, to);
+    }
+    double heuristic(Loc loc) {
+        return abs(loc.row - end.row) + abs(loc.col - end.col);
+    }
+};
+
+Vector<Loc> shortestMazePath(Loc start, Loc end, const PackedMaze& maze) {
+    int numRows = maze.numRows();
+    int numCols = maze.numCols();
+    if (start.row < 0 || start.row >= numRows ||
+        start.col < 0 || start.col >= numCols ||
+        end.row < 0 || end.row >= numRows ||
+        end.col < 0 || end.col >= numCols) {
+        error("Maze location is out of range.");
+    }
+    GridMarks marks(numRows, numCols);
+    MazeMoves moves(maze, end);
+    return gridAStar(start, end, marks, moves);
+}
+
+PackedMaze packMazeWorld(Grid<double>& world) {
+    if (world.numRows() % 2 == 0 || world.numCols() % 2 == 0) {
+        error("The world is not laid out as a maze of cells.");
+    }
+    PackedMaze maze((world.numRows() + 1) / 2, (world.numCols() + 1) / 2);
+    for (int row = 0; row < maze.numRows(); row++) {
+        for (int col = 0; col < maze.numCols(); col++) {
+            if (world[2 * row][2 * col] != kMazeFloor) {
+                error("The world is not laid out as a maze of cells.");
+            }
+            if (col < maze.numCols() - 1 &&
+                world[2 * row][2 * col + 1] == kMazeFloor) {
+                maze.setRightPassage(row, col, true);
+            }
+            if (row < maze.numRows() - 1 &&
+                world[2 * row + 1][2 * col] == kMazeFloor) {
+                maze.setDownPassage(row, col, true);
+            }
+        }
+    }
+    return maze;
+}
+
+Vector<Loc> mazePathToWorld(const Vector<Loc>& path) {
+    Vector<Loc> result;
+    for (int i = 0; i < path.size(); i++) {
+        if (i > 0) {
+            result += makeLoc(path[i - 1].row + path[i].row,
+                              path[i - 1].col + path[i].col);
+        }
+        result += makeLoc(2 * path[i].row, 2 * path[i].col);
+    }
+    return result;
+}
@@ -0,0 +1,47 @@
+/******************************************************************************
+ * File: MazeSearch.h
+ *
+ * Eric Beach
+ *
+ * Shortest path search run directly on a PackedMaze, rather than on the
+ *   Grid<double> world generateRandomMaze lays it out as.  A maze world
+ *   spends a double on each of (2m - 1) x (2n - 1) cells for an m x n maze,
+ *   about 256 bits per maze cell; a PackedMaze spends two, so even very
+ *   large mazes fit in cache.
+ */
+
+#ifndef __Trailblazer__MazeSearch__
+#define __Trailblazer__MazeSearch__
+
+#include "TrailblazerTypes.h"
+#include "PackedMaze.h"
+#include "vector.h"
+#include "grid.h"
+
+/* Function: shortestMazePath
+ *
+ * Finds the shortest path between two cells of a maze, moving only through
+ *   its passages, and returns the cells to visit in order.  This is A*
+ *   search with every passage costing 1 and the Manhattan distance as the
+ *   heuristic; it keeps one byte of state per cell.
+ * If no path is found, this function reports an error.
+ */
+Vector<Loc> shortestMazePath(Loc start, Loc end, const PackedMaze& maze);
+
+/* Function: packMazeWorld
+ *
+ * Converts a maze world laid out as generateRandomMaze lays it out (cells at
+ *   even rows and columns, passages between them) back into a PackedMaze,
+ *   so that it can be searched with shortestMazePath.  Reports an error if
+ *   the world isn't laid out that way.
+ */
+PackedMaze packMazeWorld(Grid<double>& world);
+
+/* Function: mazePathToWorld
+ *
+ * Converts a path through the cells of a maze into the matching path
+ *   through its world, with the passages between cells filled in.
+ */
+Vector<Loc> mazePathToWorld(const Vector<Loc>& path);
+
+#endif /* defined(__Trailblazer__MazeSearch__) */
@@ -0,0 +1,192 @@
+/******************************************************************************
+ * File: MultiGoalSearch.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of A* search from one start location to the nearest of
+ *   many goal locations.
+ */
+
+#include "MultiGoalSearch.h"
+#include "TrailblazerPQueue.h"
+#include "error.h"
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+/* Constant: kMinBucketSize
+ *
+ * Smallest side length of a goal bucket.  Very small buckets make the ring
+ *   walk in minHeuristic visit many empty buckets.
+ */
+const int kMinBucketSize = 4;
+
+/*
+ * Build the bucket grid.  Buckets are sized so that, on average, each one
+ *   holds about one goal.
+ */
+GoalIndex::GoalIndex(Vector<Loc>& goals, int numRows, int numCols) {
+    if (goals.isEmpty()) error("No goals given to the goal index.");
+
+    bucketSize = int(sqrt(double(numRows) * numCols / goals.size()));
+    if (bucketSize < kMinBucketSize) bucketSize = kMinBucketSize;
+
+    buckets.resize((numRows + bucketSize - 1) / bucketSize,
+                   (numCols + bucketSize - 1) / bucketSize);
+    goalCells.resize(numRows, numCols);
+    for (int i = 0; i < goals.size(); i++) {
+        Loc goal = goals[i];
+        if (!goalCells.inBounds(goal.row, goal.col)) {
+            error("Goal location is out of range.");
+        }
+        if (goalCells[goal.row][goal.col]) continue;
+        goalCells[goal.row][goal.col] = true;
+        buckets[goal.row / bucketSize][goal.col / bucketSize] += goal;
+    }
+}
+
+/*
+ * Return whether the location is one of the goals.
+ */
+bool GoalIndex::isGoal(Loc loc) {
+    return goalCells[loc.row][loc.col];
+}
+
+/*
+ * Visit the buckets in square rings of increasing distance around the
+ *   bucket containing loc.  Every goal in ring r is at least
+ *   (r - 1) * bucketSize + 1 rows or columns away from loc, so once the best
+ *   heuristic value found so far is no larger than that, no goal in this or
+ *   any later ring can improve on it.
+ */
+double GoalIndex::minHeuristic(Loc loc, Grid<double>& world,
+                               double heuristic(Loc from, Loc to,
+                                                Grid<double>& world)) {
+    int centerRow = loc.row / bucketSize;
+    int centerCol = loc.col / bucketSize;
+    int maxRing = max(buckets.numRows(), buckets.numCols());
+    double best = numeric_limits<double>::infinity();
+
+    for (int ring = 0; ring <= maxRing; ring++) {
+        if (ring > 0 && best <= (ring - 1) * bucketSize + 1) break;
+
+        for (int row = centerRow - ring; row <= centerRow + ring; row++) {
+            for (int col = centerCol - ring; col <= centerCol + ring; col++) {
+                // only the border of the square belongs to this ring
+                if (row != centerRow - ring && row != centerRow + ring &&
+                    col != centerCol - ring && col != centerCol + ring) {
+                    continue;
+                }
+                if (!buckets.inBounds(row, col)) continue;
+
+                Vector<Loc>& bucket = buckets[row][col];
+                for (int i = 0; i < bucket.size(); i++) {
+                    best = min(best, heuristic(loc, bucket[i], world));
+                }
+            }
+        }
+    }
+    return best;
+}
+
+/*
+ * This follows shortestPath in Trailblazer.cpp step for step; the only
+ *   differences are that the heuristic is the minimum over all goals and
+ *   that the search ends when any goal is dequeued.
+ */
+MultiGoalResult
+shortestPathToAny(Loc start,
+                  Vector<Loc>& goals,
+                  Grid<double>& world,
+                  double costFn(Loc from, Loc to, Grid<double>& world),
+                  double heuristic(Loc start, Loc end, Grid<double>& world)) {
+    if (!world.inBounds(start.row, start.col)) {
+        error("Start location is out of range.");
+    }
+    GoalIndex goalIndex(goals, world.numRows(), world.numCols());
+
+    // cells in the queue and parent grid are CellIds (see searchWorld)
+    int numCols = world.numCols();
+    Grid<CellId> parentNode(world.numRows(), world.numCols());
+    Grid<double> nodeCosts(world.numRows(), world.numCols());
+    Grid<Color> nodeColors(world.numRows(), world.numCols());
+
+    // the heuristic is now a search over many goals, so remember it for
+    //   each cell rather than recomputing it on every decrease-key
+    Grid<double> nodeHeuristics(world.numRows(), world.numCols());
+
+    TrailblazerPQueue<CellId> locsToExamine;
+
+    nodeColors.unchecked(start.row, start.col) = YELLOW;
+    nodeCosts.unchecked(start.row, start.col) = 0;
+    nodeHeuristics.unchecked(start.row, start.col) =
+        goalIndex.minHeuristic(start, world, heuristic);
+    locsToExamine.enqueue(makeCellId(start, numCols),
+                          nodeHeuristics.unchecked(start.row, start.col));
+
+    Loc reached;
+    while (true) {
+        if (locsToExamine.isEmpty()) {
+            error("No path exists from the start to any of the goals.");
+        }
+        CellId currId = locsToExamine.dequeueMin();
+        Loc curr = cellIdToLoc(currId, numCols);
+        nodeColors.unchecked(curr.row, curr.col) = GREEN;
+
+        // the first goal dequeued is the cheapest one to reach
+        if (goalIndex.isGoal(curr)) {
+            reached = curr;
+            break;
+        }
+
+        for (int row = curr.row - 1; row < curr.row + 2; row++) {
+            for (int col = curr.col - 1; col < curr.col + 2; col++) {
+                if (row == curr.row && col == curr.col) continue;
+                if (row < 0 || row >= world.numRows() ||
+                    col < 0 || col >= world.numCols()) continue;
+
+                Loc v = makeLoc(row, col);
+
+                // impassable moves (e.g., through maze walls) never lead
+                //   anywhere, so don't bother queueing them
+                double edgeCost = costFn(curr, v, world);
+                if (edgeCost == numeric_limits<double>::infinity()) continue;
+                double vPathCost = nodeCosts.unchecked(curr.row, curr.col) +
+                                   edgeCost;
+
+                if (nodeColors.unchecked(row, col) == GRAY) {
+                    nodeColors.unchecked(row, col) = YELLOW;
+                    nodeCosts.unchecked(row, col) = vPathCost;
+                    parentNode.unchecked(row, col) = currId;
+                    nodeHeuristics.unchecked(row, col) =
+                        goalIndex.minHeuristic(v, world, heuristic);
+                    locsToExamine.enqueue(makeCellId(v, numCols),
+                        vPathCost + nodeHeuristics.unchecked(row, col));
+                } else if (nodeColors.unchecked(row, col) == YELLOW &&
+                           nodeCosts.unchecked(row, col) > vPathCost) {
+                    nodeCosts.unchecked(row, col) = vPathCost;
+                    parentNode.unchecked(row, col) = currId;
+                    locsToExamine.decreaseKey(makeCellId(v, numCols),
+                        vPathCost + nodeHeuristics.unchecked(row, col));
+                }
+            }
+        }
+    }
+
+    // trace back from the goal that was reached
+    Vector<Loc> tempReversePath;
+    Loc curr = reached;
+    while (curr != start) {
+        tempReversePath += curr;
+        curr = cellIdToLoc(parentNode.unchecked(curr.row, curr.col), numCols);
+    }
+    tempReversePath += start;
+
+    MultiGoalResult result;
+    result.goal = reached;
+    for (int i = tempReversePath.size() - 1; i >= 0; i--) {
+        result.path += tempReversePath[i];
+    }
+    return result;
+}
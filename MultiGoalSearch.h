@@ -0,0 +1,78 @@
+/******************************************************************************
+ * File: MultiGoalSearch.h
+ *
+ * Eric Beach
+ *
+ * A* search from a single start location to whichever of many goal
+ *   locations is cheapest to reach.  This replaces running shortestPath once
+ *   per goal and keeping the best answer.
+ */
+
+#ifndef __Trailblazer__MultiGoalSearch__
+#define __Trailblazer__MultiGoalSearch__
+
+#include "TrailblazerTypes.h"
+#include "vector.h"
+#include "grid.h"
+
+/* Type: MultiGoalResult
+ *
+ * The outcome of a multi-goal search: the goal that was reached and the
+ *   path to it, with the start location at element 0 and the goal at the
+ *   end.
+ */
+struct MultiGoalResult {
+    Loc goal;
+    Vector<Loc> path;
+};
+
+/*
+ * Spatial index over a set of goal locations.  The goals are bucketed into
+ *   square blocks of cells so that the goals nearest a location can be
+ *   visited first and far-away blocks skipped entirely.
+ * The index is used to evaluate min over all goals g of heuristic(loc, g)
+ *   without looking at every goal.  This relies on the heuristic never being
+ *   smaller than the number of rows or columns separating the two locations
+ *   (true of terrainHeuristic and mazeHeuristic); zeroHeuristic also works,
+ *   since nothing can beat an estimate of zero.
+ */
+class GoalIndex {
+public:
+    // build the index over the given goals in a world of the given size
+    GoalIndex(Vector<Loc>& goals, int numRows, int numCols);
+
+    // return whether the location is one of the goals
+    bool isGoal(Loc loc);
+
+    // return the smallest heuristic value from loc to any goal
+    double minHeuristic(Loc loc, Grid<double>& world,
+                        double heuristic(Loc from, Loc to,
+                                         Grid<double>& world));
+
+private:
+    // side length, in cells, of each bucket
+    int bucketSize;
+
+    // the goals that fall in each bucket
+    Grid< Vector<Loc> > buckets;
+
+    // whether each cell of the world is a goal
+    Grid<bool> goalCells;
+};
+
+/* Function: shortestPathToAny
+ *
+ * Finds the cheapest path from start to any of the given goals using A*
+ *   search, where the heuristic for a location is the minimum of the
+ *   heuristic over all goals.  The search stops as soon as the first goal is
+ *   dequeued, so the returned goal is the one with the cheapest path.  If no
+ *   goal can be reached, this function reports an error.
+ */
+MultiGoalResult
+shortestPathToAny(Loc start,
+                  Vector<Loc>& goals,
+                  Grid<double>& world,
+                  double costFn(Loc from, Loc to, Grid<double>& world),
+                  double heuristic(Loc start, Loc end, Grid<double>& world));
+
+#endif /* defined(__Trailblazer__MultiGoalSearch__) */
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * File: PackedMaze.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of a maze stored as two bits per cell.
+ */
+
+#include "PackedMaze.h"
+#include "error.h"
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+PackedMaze::PackedMaze() {
+    rows = 0;
+    cols = 0;
+}
+
+PackedMaze::PackedMaze(int numRows, int numCols) {
+    if (numRows < 0 || numCols < 0) error("Maze size must not be negative.");
+    rows = numRows;
+    cols = numCols;
+    // two bits per cell, rounded up to whole bytes
+    bits.assign(((long long) numRows * numCols * 2 + 7) / 8, 0);
+}
+
+int PackedMaze::numRows() const {
+    return rows;
+}
+
+int PackedMaze::numCols() const {
+    return cols;
+}
+
+bool PackedMaze::hasRightPassage(int row, int col) const {
+    return getBit(cellBit(row, col));
+}
+
+bool PackedMaze::hasDownPassage(int row, int col) const {
+    return getBit(cellBit(row, col) + 1);
+}
+
+void PackedMaze::setRightPassage(int row, int col, bool open) {
+    if (col == cols - 1 && open) error("No cell to the right of this one.");
+    setBit(cellBit(row, col), open);
+}
+
+void PackedMaze::setDownPassage(int row, int col, bool open) {
+    if (row == rows - 1 && open) error("No cell below this one.");
+    setBit(cellBit(row, col) + 1, open);
+}
+
+/*
+ * Work out which of the two cells is up / left of the other and look at
+ *   the matching bit of that cell.
+ */
+bool PackedMaze::hasPassage(Loc a, Loc b) const {
+    if (b < a) swap(a, b);
+    if (a.row == b.row && b.col == a.col + 1) {
+        return hasRightPassage(a.row, a.col);
+    }
+    if (a.col == b.col && b.row == a.row + 1) {
+        return hasDownPassage(a.row, a.col);
+    }
+    return false;
+}
+
+void PackedMaze::openPassage(Edge edge) {
+    Loc a = edge.start;
+    Loc b = edge.end;
+    if (b < a) swap(a, b);
+    if (a.row == b.row && b.col == a.col + 1) {
+        setRightPassage(a.row, a.col, true);
+    } else if (a.col == b.col && b.row == a.row + 1) {
+        setDownPassage(a.row, a.col, true);
+    } else {
+        error("Maze passages must join adjacent cells.");
+    }
+}
+
+Set<Edge> PackedMaze::toEdgeSet() const {
+    Set<Edge> result;
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            Loc curr = makeLoc(row, col);
+            if (hasRightPassage(row, col)) {
+                result += makeEdge(curr, makeLoc(row, col + 1));
+            }
+            if (hasDownPassage(row, col)) {
+                result += makeEdge(curr, makeLoc(row + 1, col));
+            }
+        }
+    }
+    return result;
+}
+
+double PackedMaze::passageCost(Loc from, Loc to) const {
+    if (hasPassage(from, to)) return 1.0;
+    return numeric_limits<double>::infinity();
+}
+
+////////// PRIVATE METHODS //////////
+bool PackedMaze::getBit(int index) const {
+    return (bits[index >> 3] >> (index & 7)) & 1;
+}
+
+void PackedMaze::setBit(int index, bool value) {
+    unsigned char mask = (unsigned char) (1 << (index & 7));
+    if (value) {
+        bits[index >> 3] |= mask;
+    } else {
+        bits[index >> 3] &= (unsigned char) ~mask;
+    }
+}
+
+int PackedMaze::cellBit(int row, int col) const {
+    if (row < 0 || row >= rows || col < 0 || col >= cols) {
+        error("Maze location is out of range.");
+    }
+    return 2 * (row * cols + col);
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * File: PackedMaze.h
+ *
+ * Eric Beach
+ *
+ * A compact representation of a maze as a bitset: two bits per cell, one for
+ *   the passage to the right and one for the passage down.  A Set<Edge>
+ *   spends a whole tree node (several pointers plus two Locs) on each
+ *   passage; this spends a quarter of a byte per cell.
+ */
+
+#ifndef __Trailblazer__PackedMaze__
+#define __Trailblazer__PackedMaze__
+
+#include "TrailblazerTypes.h"
+#include "set.h"
+#include <vector>
+
+/*
+ * The passages of a maze of numRows x numCols cells.  Every passage joins
+ *   a cell to its right or lower neighbor, so each is stored with the cell
+ *   above or to the left of it.  A new PackedMaze has no passages at all.
+ */
+class PackedMaze {
+public:
+    // create an empty maze of the given size
+    PackedMaze();
+    PackedMaze(int numRows, int numCols);
+
+    int numRows() const;
+    int numCols() const;
+
+    // return whether there is a passage from (row, col) to the cell to its
+    //   right / below it
+    bool hasRightPassage(int row, int col) const;
+    bool hasDownPassage(int row, int col) const;
+
+    // open or close the passage from (row, col) to the cell to its right /
+    //   below it
+    void setRightPassage(int row, int col, bool open);
+    void setDownPassage(int row, int col, bool open);
+
+    // return whether there is a passage between two adjacent cells, in
+    //   either order; non-adjacent cells never have one
+    bool hasPassage(Loc a, Loc b) const;
+
+    // open the passage an edge describes (the endpoints may be in either
+    //   order, but must be adjacent)
+    void openPassage(Edge edge);
+
+    // return every passage as an Edge, for code that wants a Set<Edge>
+    //   (e.g., createMaze)
+    Set<Edge> toEdgeSet() const;
+
+    // return the cost of moving from one cell to another, in the manner of
+    //   mazeCost: 1 if there is a passage between them, infinite otherwise,
+    //   so a search can walk the maze directly
+    double passageCost(Loc from, Loc to) const;
+
+private:
+    int rows;
+    int cols;
+
+    // bit 2 * (row * cols + col) is the right passage of (row, col) and the
+    //   bit after it is the down passage
+    std::vector<unsigned char> bits;
+
+    bool getBit(int index) const;
+    void setBit(int index, bool value);
+
+    // return the index of the right passage bit of a cell, checking bounds
+    int cellBit(int row, int col) const;
+};
+
+#endif /* defined(__Trailblazer__PackedMaze__) */
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * File: Parallel.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of a minimal parallel-for on POSIX threads.
+ */
+
+#include "Parallel.h"
+#include "vector.h"
+#include "error.h"
+#include <pthread.h>
+#include <unistd.h>
+
+using namespace std;
+
+/*
+ * One chunk of a parallelFor, handed to the thread that runs it.  Each
+ *   thread gets its own chunk, which lives in a Vector owned by parallelFor
+ *   until all of the threads have been joined.  If body reports an error,
+ *   the message is kept in the chunk for parallelFor to report again.
+ */
+struct ParallelChunk {
+    int begin;
+    int end;
+    void (*body)(int, int, void*);
+    void* data;
+    bool failed;
+    string errorMessage;
+};
+
+/*
+ * Thread entry point: run one chunk.  An exception must not leave a thread
+ *   started by pthread_create (it would end the whole program), so errors
+ *   are caught here and stored in the chunk instead.
+ */
+static void* runChunk(void* arg) {
+    ParallelChunk* chunk = (ParallelChunk*) arg;
+    try {
+        chunk->body(chunk->begin, chunk->end, chunk->data);
+    } catch (ErrorException& ex) {
+        chunk->failed = true;
+        chunk->errorMessage = ex.getMessage();
+    }
+    return NULL;
+}
+
+int numWorkerThreads() {
+    long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    return numProcessors < 1 ? 1 : int(numProcessors);
+}
+
+/*
+ * The calling thread runs the first chunk itself rather than sitting idle
+ *   while it waits for the others.  If a thread can't be started, its chunk
+ *   is run on the calling thread instead.  Errors are only reported once
+ *   every thread has been joined, since the threads still use the chunks.
+ */
+void parallelFor(int count,
+                 void body(int begin, int end, void* data),
+                 void* data) {
+    int numThreads = numWorkerThreads();
+    if (numThreads > count) numThreads = count;
+    if (numThreads <= 1) {
+        if (count > 0) body(0, count, data);
+        return;
+    }
+
+    Vector<ParallelChunk> chunks;
+    for (int i = 0; i < numThreads; i++) {
+        ParallelChunk chunk;
+        chunk.begin = int((long long) count * i / numThreads);
+        chunk.end = int((long long) count * (i + 1) / numThreads);
+        chunk.body = body;
+        chunk.data = data;
+        chunk.failed = false;
+        chunks += chunk;
+    }
+
+    Vector<pthread_t> threads(numThreads);
+    Vector<bool> started(numThreads, false);
+    for (int i = 1; i < numThreads; i++) {
+        started[i] = pthread_create(&threads[i], NULL,
+                                    runChunk, &chunks[i]) == 0;
+    }
+    runChunk(&chunks[0]);
+    for (int i = 1; i < numThreads; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            runChunk(&chunks[i]);
+        }
+    }
+    for (int i = 0; i < numThreads; i++) {
+        if (chunks[i].failed) error(chunks[i].errorMessage);
+    }
+}
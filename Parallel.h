@@ -0,0 +1,39 @@
+/******************************************************************************
+ * File: Parallel.h
+ *
+ * Eric Beach
+ *
+ * A minimal parallel-for built directly on POSIX threads, used to spread
+ *   work over a grid (e.g., labelling or generating a world) across all of
+ *   the machine's cores.
+ */
+
+#ifndef __Trailblazer__Parallel__
+#define __Trailblazer__Parallel__
+
+/* Function: numWorkerThreads
+ *
+ * Returns the number of threads parallelFor splits its work across, which is
+ *   the number of processors online (and at least 1).
+ */
+int numWorkerThreads();
+
+/* Function: parallelFor
+ *
+ * Splits the range [0, count) into one contiguous chunk per worker thread
+ *   and calls body(begin, end, data) for each chunk, all at the same time.
+ *   Returns once every chunk has finished.  body must be safe to call from
+ *   several threads at once; data is passed through unchanged and is
+ *   typically a struct holding the shared state of the loop.
+ * Small ranges, or machines with a single processor, are run on the calling
+ *   thread.
+ * If body reports an error (i.e., throws an ErrorException) on any thread,
+ *   the other chunks still run to the end, and then parallelFor reports the
+ *   error from the first such chunk on the calling thread.  body must not
+ *   throw any other kind of exception.
+ */
+void parallelFor(int count,
+                 void body(int begin, int end, void* data),
+                 void* data);
+
+#endif /* defined(__Trailblazer__Parallel__) */
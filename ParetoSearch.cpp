@@ -0,0 +1,235 @@
+/******************************************************************************
+ * File: ParetoSearch.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of a bi-objective (distance vs. climb) label-setting search
+ *   in the style of NAMOA*.
+ * http://en.wikipedia.org/wiki/Multi-objective_optimization
+ */
+
+#include "ParetoSearch.h"
+#include "error.h"
+#include <cmath>
+#include <queue>
+#include <vector>
+
+using namespace std;
+
+/* Constant: kDominanceEpsilon
+ *
+ * Climb values are sums of floating point height differences, so two routes
+ *   of mathematically equal cost can differ in the last few bits.  Treat
+ *   values this close together as equal when comparing labels.
+ */
+const double kDominanceEpsilon = 1e-9;
+
+/*
+ * A label is one partial path that reached a cell.  All labels live in a
+ *   single flat pool and refer to each other by index, so the store costs
+ *   a few machine words per label and no per-cell containers.  The labels
+ *   that reached a given cell are threaded together through nextAtCell,
+ *   starting from cellHead[cell].
+ */
+struct ParetoLabel {
+    double distance;
+    double climb;
+    int cell;
+    int parent;
+    int nextAtCell;
+    bool alive;
+};
+
+/*
+ * Entry in the open list.  Entries are ordered lexicographically on the
+ *   estimated (distance, climb) of a full path through the label, which
+ *   guarantees that every label reaching the end cell is dequeued after
+ *   any label that could dominate it.
+ */
+struct ParetoOpenEntry {
+    double distance;
+    double climb;
+    int label;
+};
+
+/*
+ * Comparator that turns std::priority_queue (a max-heap) into a min-heap
+ *   on the lexicographic order of (distance, climb).
+ */
+struct ParetoOpenEntryGreater {
+    bool operator()(const ParetoOpenEntry& a, const ParetoOpenEntry& b) const {
+        if (a.distance != b.distance) return a.distance > b.distance;
+        return a.climb > b.climb;
+    }
+};
+
+/*
+ * Return whether the cost vector (d1, c1) is at least as good as (d2, c2)
+ *   in both objectives.
+ */
+static bool weaklyDominates(double d1, double c1, double d2, double c2) {
+    return d1 <= d2 + kDominanceEpsilon && c1 <= c2 + kDominanceEpsilon;
+}
+
+/*
+ * Admissible estimate of the remaining horizontal distance on an
+ *   8-connected grid (the octile distance).
+ */
+static double distanceHeuristic(int row, int col, Loc end) {
+    int drow = abs(end.row - row);
+    int dcol = abs(end.col - col);
+    int diagonal = min(drow, dcol);
+    int straight = max(drow, dcol) - diagonal;
+    return straight + sqrt(2.0) * diagonal;
+}
+
+/*
+ * Return whether a full path with the estimated cost (distance, climb) is
+ *   already beaten by one of the solutions found so far.
+ * Solutions are found in order of increasing distance, and each one must
+ *   climb less than the one before it to be on the frontier at all.  Every
+ *   estimate examined from here on has at least the distance of all the
+ *   solutions (the heuristics are consistent), so the most recent solution,
+ *   which climbs the least, is the only one that needs checking.
+ */
+static bool dominatedBySolution(double distance, double climb,
+                                Vector<int>& solutions,
+                                vector<ParetoLabel>& labels) {
+    if (solutions.isEmpty()) return false;
+    ParetoLabel& last = labels[solutions[solutions.size() - 1]];
+    return weaklyDominates(last.distance, last.climb, distance, climb);
+}
+
+/*
+ * Follow the parent links from a label at the end cell back to the start
+ *   and return the path in start-to-end order.
+ */
+static Vector<Loc> tracePath(int label, vector<ParetoLabel>& labels,
+                             int numCols) {
+    Vector<Loc> reversePath;
+    for (int curr = label; curr != -1; curr = labels[curr].parent) {
+        reversePath += makeLoc(labels[curr].cell / numCols,
+                               labels[curr].cell % numCols);
+    }
+    Vector<Loc> path;
+    for (int i = reversePath.size() - 1; i >= 0; i--) {
+        path += reversePath[i];
+    }
+    return path;
+}
+
+Vector<ParetoPath> paretoShortestPaths(Loc start, Loc end, Grid<double>& world) {
+    if (!world.inBounds(start.row, start.col) ||
+        !world.inBounds(end.row, end.col)) {
+        error("Pareto search endpoints are out of range.");
+    }
+    int numRows = world.numRows();
+    int numCols = world.numCols();
+    double endHeight = world[end.row][end.col];
+
+    // flat label pool plus the head of each cell's list of labels
+    vector<ParetoLabel> labels;
+    Vector<int> cellHead(numRows * numCols, -1);
+
+    // labels that reached the end cell, in order of increasing distance
+    Vector<int> solutions;
+
+    priority_queue<ParetoOpenEntry, vector<ParetoOpenEntry>,
+                   ParetoOpenEntryGreater> open;
+
+    // seed the search with a zero-cost label at the start cell
+    ParetoLabel first = { 0.0, 0.0, start.row * numCols + start.col,
+                          -1, -1, true };
+    labels.push_back(first);
+    cellHead[first.cell] = 0;
+    ParetoOpenEntry firstEntry = {
+        distanceHeuristic(start.row, start.col, end),
+        fabs(endHeight - world[start.row][start.col]),
+        0
+    };
+    open.push(firstEntry);
+
+    while (!open.empty()) {
+        ParetoOpenEntry entry = open.top();
+        open.pop();
+
+        // skip labels that were dominated after they were enqueued, as well
+        //   as labels that cannot lead to a new point on the frontier
+        if (!labels[entry.label].alive) continue;
+        if (dominatedBySolution(entry.distance, entry.climb,
+                                solutions, labels)) {
+            labels[entry.label].alive = false;
+            continue;
+        }
+
+        int currRow = labels[entry.label].cell / numCols;
+        int currCol = labels[entry.label].cell % numCols;
+        if (currRow == end.row && currCol == end.col) {
+            solutions += entry.label;
+            continue;
+        }
+
+        double currHeight = world.unchecked(currRow, currCol);
+        for (int row = currRow - 1; row < currRow + 2; row++) {
+            for (int col = currCol - 1; col < currCol + 2; col++) {
+                if (row == currRow && col == currCol) continue;
+                if (row < 0 || row >= numRows ||
+                    col < 0 || col >= numCols) continue;
+
+                double step = (row != currRow && col != currCol) ?
+                              sqrt(2.0) : 1.0;
+                double distance = labels[entry.label].distance + step;
+                double climb = labels[entry.label].climb +
+                               fabs(world.unchecked(row, col) - currHeight);
+
+                ParetoOpenEntry next = {
+                    distance + distanceHeuristic(row, col, end),
+                    climb + fabs(endHeight - world.unchecked(row, col)),
+                    -1
+                };
+                if (dominatedBySolution(next.distance, next.climb,
+                                        solutions, labels)) continue;
+
+                // compare against every live label at the neighbor: drop
+                //   the new label if something there is at least as good,
+                //   and retire any labels the new one beats
+                int cell = row * numCols + col;
+                bool dominated = false;
+                int* link = &cellHead[cell];
+                while (*link != -1) {
+                    ParetoLabel& other = labels[*link];
+                    if (weaklyDominates(other.distance, other.climb,
+                                        distance, climb)) {
+                        dominated = true;
+                        break;
+                    }
+                    if (weaklyDominates(distance, climb,
+                                        other.distance, other.climb)) {
+                        other.alive = false;
+                        *link = other.nextAtCell;
+                    } else {
+                        link = &other.nextAtCell;
+                    }
+                }
+                if (dominated) continue;
+
+                ParetoLabel label = { distance, climb, cell, entry.label,
+                                      cellHead[cell], true };
+                next.label = int(labels.size());
+                labels.push_back(label);
+                cellHead[cell] = next.label;
+                open.push(next);
+            }
+        }
+    }
+
+    Vector<ParetoPath> frontier;
+    for (int i = 0; i < solutions.size(); i++) {
+        ParetoPath result;
+        tracePath(solutions[i], labels, numCols).swap(result.path);
+        result.distance = labels[solutions[i]].distance;
+        result.climb = labels[solutions[i]].climb;
+        frontier += result;
+    }
+    return frontier;
+}
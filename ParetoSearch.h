@@ -0,0 +1,46 @@
+/******************************************************************************
+ * File: ParetoSearch.h
+ *
+ * Eric Beach
+ *
+ * Bi-objective search over a terrain.  Rather than folding horizontal distance
+ *   and altitude change into a single cost with a fixed altitude penalty (as
+ *   terrainCost does), this search keeps the two objectives apart and returns
+ *   every path that is not beaten on both of them by some other path (i.e.,
+ *   the Pareto frontier).
+ * http://en.wikipedia.org/wiki/Pareto_efficiency
+ */
+
+#ifndef __Trailblazer__ParetoSearch__
+#define __Trailblazer__ParetoSearch__
+
+#include "TrailblazerTypes.h"
+#include "vector.h"
+#include "grid.h"
+
+/* Type: ParetoPath
+ *
+ * A single path on the Pareto frontier along with its two objective values.
+ *   distance is the horizontal length of the path (1 per cardinal step and
+ *   sqrt(2) per diagonal step) and climb is the total absolute change in
+ *   altitude along the path.
+ */
+struct ParetoPath {
+    Vector<Loc> path;
+    double distance;
+    double climb;
+};
+
+/* Function: paretoShortestPaths
+ *
+ * Finds the Pareto frontier of (distance, climb) paths between start and end
+ *   in the given terrain.  The paths are returned in order of increasing
+ *   distance (and therefore decreasing climb).
+ *
+ * Because terrainCost is distance + k * climb, the cheapest path under any
+ *   altitude penalty k >= 0 is always one of the returned paths, so a single
+ *   call answers the question for every vehicle weighting at once.
+ */
+Vector<ParetoPath> paretoShortestPaths(Loc start, Loc end, Grid<double>& world);
+
+#endif /* defined(__Trailblazer__ParetoSearch__) */
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * File: PathSmoother.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of greedy string pulling over grid paths.
+ * http://en.wikipedia.org/wiki/Any-angle_path_planning
+ */
+
+#include "PathSmoother.h"
+
+using namespace std;
+
+/* Constant: kCostTolerance
+ *
+ * Slack allowed when comparing a straight segment against the cell-by-cell
+ *   path it replaces, so that rounding in the two sums does not stop a
+ *   segment that is really the same cost (e.g., a straight run of cells).
+ */
+const double kCostTolerance = 1e-9;
+
+/*
+ * Greedy string pulling.  Starting from an anchor waypoint, keep stretching
+ *   a straight segment to later and later cells on the path for as long as
+ *   the segment costs no more than the path between its endpoints.  When
+ *   the next cell would break that, the last cell that worked becomes a
+ *   waypoint and the new anchor.
+ */
+Vector<Loc> smoothPath(Vector<Loc>& path,
+                       Grid<double>& world,
+                       double segmentCost(Loc from, Loc to,
+                                          Grid<double>& world)) {
+    if (path.size() <= 2) return path;
+
+    // prefixCost[i] is the cost of the original path from path[0] to path[i],
+    //   which gives the cost of any stretch of the path in constant time
+    Vector<double> prefixCost(path.size(), 0.0);
+    for (int i = 1; i < path.size(); i++) {
+        prefixCost[i] = prefixCost[i - 1] +
+                        segmentCost(path[i - 1], path[i], world);
+    }
+
+    Vector<Loc> waypoints;
+    waypoints += path[0];
+    int anchor = 0;
+    while (anchor < path.size() - 1) {
+        // the very next cell is always reachable at exactly the path cost
+        int farthest = anchor + 1;
+        for (int next = anchor + 2; next < path.size(); next++) {
+            double pathCost = prefixCost[next] - prefixCost[anchor];
+            double straightCost = segmentCost(path[anchor], path[next], world);
+            if (straightCost > pathCost + kCostTolerance) break;
+            farthest = next;
+        }
+        waypoints += path[farthest];
+        anchor = farthest;
+    }
+    return waypoints;
+}
@@ -0,0 +1,38 @@
+/******************************************************************************
+ * File: PathSmoother.h
+ *
+ * Eric Beach
+ *
+ * Any-angle post-processing of grid paths (i.e., "string pulling").  A path
+ *   returned by shortestPath visits every cell along the way and zigzags
+ *   between the eight grid directions; smoothing replaces runs of cells with
+ *   straight segments wherever that is no more expensive, leaving a short
+ *   list of waypoints.
+ * http://en.wikipedia.org/wiki/Any-angle_path_planning
+ */
+
+#ifndef __Trailblazer__PathSmoother__
+#define __Trailblazer__PathSmoother__
+
+#include "TrailblazerTypes.h"
+#include "vector.h"
+#include "grid.h"
+
+/* Function: smoothPath
+ *
+ * Takes a path of adjacent cells and returns a list of waypoints, starting
+ *   and ending at the same locations, where consecutive waypoints are joined
+ *   by straight segments.  segmentCost gives the cost of travelling in a
+ *   straight line between any two locations (e.g., terrainSegmentCost or
+ *   mazeSegmentCost) and must agree with the grid cost function on adjacent
+ *   locations.
+ * Each segment is only taken if it costs no more than the part of the
+ *   original path it replaces, so the smoothed path is never more expensive
+ *   than the input.
+ */
+Vector<Loc> smoothPath(Vector<Loc>& path,
+                       Grid<double>& world,
+                       double segmentCost(Loc from, Loc to,
+                                          Grid<double>& world));
+
+#endif /* defined(__Trailblazer__PathSmoother__) */
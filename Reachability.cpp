@@ -0,0 +1,136 @@
+/******************************************************************************
+ * File: Reachability.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of connected-component labelling of a world.
+ * http://en.wikipedia.org/wiki/Connected-component_labeling
+ */
+
+#include "Reachability.h"
+#include "ConcurrentUnionFind.h"
+#include "Parallel.h"
+#include "error.h"
+#include <limits>
+
+using namespace std;
+
+/*
+ * Moves that need to be checked from each cell.  Since components are
+ *   undirected, only half of the eight neighbors are needed: the others are
+ *   covered when their own cell is visited.
+ */
+const int kNumForwardMoves = 4;
+const int kForwardRows[kNumForwardMoves] = { 0, 1, 1, 1 };
+const int kForwardCols[kNumForwardMoves] = { 1, -1, 0, 1 };
+
+ReachabilityIndex::ReachabilityIndex() {
+    componentCount = 0;
+}
+
+ReachabilityIndex::ReachabilityIndex(Grid<double>& world,
+                                     double costFn(Loc from, Loc to,
+                                                   Grid<double>& world)) {
+    build(world, costFn);
+}
+
+/*
+ * State shared by the threads labelling a world.
+ */
+struct LabelState {
+    Grid<double>* world;
+    double (*costFn)(Loc, Loc, Grid<double>&);
+    ConcurrentUnionFind* components;
+    Grid<int>* labels;
+};
+
+/*
+ * Join the sets of every pair of adjacent cells that can be moved between,
+ *   for rows begin to end - 1.  Several threads run this at once on
+ *   different rows of the same ConcurrentUnionFind.
+ */
+static void joinRows(int begin, int end, void* data) {
+    LabelState* state = (LabelState*) data;
+    Grid<double>& world = *state->world;
+    int numCols = world.numCols();
+    for (int row = begin; row < end; row++) {
+        for (int col = 0; col < numCols; col++) {
+            Loc curr = makeLoc(row, col);
+            for (int i = 0; i < kNumForwardMoves; i++) {
+                int vRow = row + kForwardRows[i];
+                int vCol = col + kForwardCols[i];
+                if (!world.inBounds(vRow, vCol)) continue;
+
+                Loc v = makeLoc(vRow, vCol);
+                if (state->costFn(curr, v, world) ==
+                    numeric_limits<double>::infinity()) continue;
+                state->components->unite(row * numCols + col,
+                                         vRow * numCols + vCol);
+            }
+        }
+    }
+}
+
+/*
+ * Record the root of each cell in rows begin to end - 1 as its label.
+ */
+static void labelRows(int begin, int end, void* data) {
+    LabelState* state = (LabelState*) data;
+    Grid<int>& labels = *state->labels;
+    int numCols = labels.numCols();
+    for (int row = begin; row < end; row++) {
+        for (int col = 0; col < numCols; col++) {
+            labels[row][col] = state->components->findIndex(row * numCols +
+                                                            col);
+        }
+    }
+}
+
+/*
+ * Join the sets of adjacent connected cells, and then record each cell's
+ *   root as its label so that later queries don't need the UnionFind at
+ *   all.  Both passes are split by rows across threads; the labels can only
+ *   be read off once every join has finished.
+ */
+void ReachabilityIndex::build(Grid<double>& world,
+                              double costFn(Loc from, Loc to,
+                                            Grid<double>& world)) {
+    int numRows = world.numRows();
+    int numCols = world.numCols();
+    ConcurrentUnionFind components(numRows * numCols);
+    componentLabels.resize(numRows, numCols);
+
+    LabelState state;
+    state.world = &world;
+    state.costFn = costFn;
+    state.components = &components;
+    state.labels = &componentLabels;
+    parallelFor(numRows, joinRows, &state);
+    parallelFor(numRows, labelRows, &state);
+
+    // each component has exactly one cell that is its own root
+    componentCount = 0;
+    for (int row = 0; row < numRows; row++) {
+        for (int col = 0; col < numCols; col++) {
+            if (componentLabels[row][col] == row * numCols + col) {
+                componentCount++;
+            }
+        }
+    }
+}
+
+/*
+ * Two cells are connected exactly when they were given the same label.
+ */
+bool ReachabilityIndex::isReachable(Loc start, Loc end) {
+    if (!componentLabels.inBounds(start.row, start.col) ||
+        !componentLabels.inBounds(end.row, end.col)) {
+        return false;
+    }
+    return componentLabels[start.row][start.col] ==
+           componentLabels[end.row][end.col];
+}
+
+int ReachabilityIndex::numComponents() {
+    return componentCount;
+}
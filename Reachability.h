@@ -0,0 +1,56 @@
+/******************************************************************************
+ * File: Reachability.h
+ *
+ * Eric Beach
+ *
+ * Connected-component labelling of a world, used to answer "can end be
+ *   reached from start at all?" before running a search.  Without it, a
+ *   search between two walled-off regions of a maze visits every cell it can
+ *   reach before giving up.
+ * http://en.wikipedia.org/wiki/Connected-component_labeling
+ */
+
+#ifndef __Trailblazer__Reachability__
+#define __Trailblazer__Reachability__
+
+#include "TrailblazerTypes.h"
+#include "grid.h"
+
+/*
+ * Labels every cell of a world with the connected component it belongs to.
+ *   Two adjacent cells are connected if the cost of moving between them is
+ *   finite.  Costs are assumed to be finite in both directions or in neither
+ *   (as with terrainCost and mazeCost), so the components are undirected.
+ * The labelling is done once per world (using ConcurrentUnionFind, split
+ *   across threads) and after that each query is a constant time
+ *   comparison of two labels.
+ */
+class ReachabilityIndex {
+public:
+    // create an empty index; every query fails until build is called
+    ReachabilityIndex();
+
+    // create an index for the given world and cost function
+    ReachabilityIndex(Grid<double>& world,
+                      double costFn(Loc from, Loc to, Grid<double>& world));
+
+    // (re)label the components of the given world, replacing any previous
+    //   labels; must be called again whenever the world changes
+    void build(Grid<double>& world,
+               double costFn(Loc from, Loc to, Grid<double>& world));
+
+    // return whether there is any path at all from start to end
+    bool isReachable(Loc start, Loc end);
+
+    // return the number of distinct components in the world
+    int numComponents();
+
+private:
+    // component label for each cell; cells in the same component share
+    //   a label
+    Grid<int> componentLabels;
+
+    int componentCount;
+};
+
+#endif /* defined(__Trailblazer__Reachability__) */
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * File: RollbackUnionFind.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of a UnionFind data structure whose joins can be undone.
+ * http://en.wikipedia.org/wiki/Disjoint-set_data_structure
+ */
+
+#include "RollbackUnionFind.h"
+#include <limits>
+
+using namespace std;
+
+RollbackUnionFind::RollbackUnionFind(const int maxSetNum, const int numCols) {
+    // every node number must fit in a UnionFindIndex
+    if (maxSetNum < 0 ||
+        (unsigned int) maxSetNum > numeric_limits<UnionFindIndex>::max()) {
+        error("Too many nodes for the UnionFind index type");
+    }
+    MAX_SET_NUM = maxSetNum;
+    NUM_COLS = numCols;
+    nodeParents = new UnionFindIndex[MAX_SET_NUM];
+    nodeRanks = new unsigned char[MAX_SET_NUM];
+}
+
+/*
+ * Destructor to cleanup the allocated memory.
+ */
+RollbackUnionFind::~RollbackUnionFind() {
+    delete[] nodeParents;
+    delete[] nodeRanks;
+}
+
+Loc RollbackUnionFind::find(const Loc& toFind) {
+    int root = findIndex(toFind.col + toFind.row * NUM_COLS);
+    return makeLoc(root / NUM_COLS, root % NUM_COLS);
+}
+
+bool RollbackUnionFind::join(const Loc& a, const Loc& b) {
+    return unite(a.col + a.row * NUM_COLS, b.col + b.row * NUM_COLS);
+}
+
+void RollbackUnionFind::makeSet(const Loc& input) {
+    makeSet(input.col + input.row * NUM_COLS);
+}
+
+void RollbackUnionFind::makeSet(const int nodeNum) {
+    checkNodeNum(nodeNum);
+    nodeParents[nodeNum] = nodeNum;
+    nodeRanks[nodeNum] = 0;
+}
+
+int RollbackUnionFind::findIndex(const int nodeNum) {
+    checkNodeNum(nodeNum);
+    return findRoot(nodeNum);
+}
+
+/*
+ * Join by rank: the root of the shallower tree becomes a child of the root
+ *   of the deeper one, and the rank only goes up when the two are equally
+ *   deep.  A tree of rank r has at least 2^r nodes, so ranks stay tiny.
+ *   Every successful join is logged so that rollback can undo it.
+ */
+bool RollbackUnionFind::unite(const int a, const int b) {
+    checkNodeNum(a);
+    checkNodeNum(b);
+    int aRoot = findRoot(a);
+    int bRoot = findRoot(b);
+    if (aRoot == bRoot) return false;
+
+    if (nodeRanks[aRoot] < nodeRanks[bRoot]) {
+        int temp = aRoot;
+        aRoot = bRoot;
+        bRoot = temp;
+    }
+    JoinRecord record;
+    record.child = bRoot;
+    record.rankIncreased = nodeRanks[aRoot] == nodeRanks[bRoot];
+
+    nodeParents[bRoot] = aRoot;
+    if (record.rankIncreased) nodeRanks[aRoot]++;
+    joinLog += record;
+    return true;
+}
+
+bool RollbackUnionFind::connected(const int a, const int b) {
+    checkNodeNum(a);
+    checkNodeNum(b);
+    return findRoot(a) == findRoot(b);
+}
+
+/*
+ * The state is entirely determined by how many joins have been made, so
+ *   the length of the log serves as the marker.
+ */
+int RollbackUnionFind::snapshot() {
+    return joinLog.size();
+}
+
+/*
+ * Undo joins from the end of the log back to the snapshot.  Each join only
+ *   changed the parent of one root and possibly the rank of another, and
+ *   since later joins are undone first, both are exactly as the join left
+ *   them.
+ */
+void RollbackUnionFind::rollback(const int snapshot) {
+    if (snapshot < 0 || snapshot > joinLog.size()) {
+        error("Invalid snapshot passed to rollback");
+    }
+    while (joinLog.size() > snapshot) {
+        JoinRecord record = joinLog[joinLog.size() - 1];
+        joinLog.remove(joinLog.size() - 1);
+
+        int parent = nodeParents[record.child];
+        if (record.rankIncreased) nodeRanks[parent]--;
+        nodeParents[record.child] = record.child;
+    }
+}
+
+////////// PRIVATE METHODS //////////
+/*
+ * Node numbers index straight into the arrays, so make sure they are in
+ *   range before using them.
+ */
+void RollbackUnionFind::checkNodeNum(const int nodeNum) {
+    if (nodeNum < 0 || nodeNum >= MAX_SET_NUM) error("Array out of bounds");
+}
+
+/*
+ * Walk up to the root without changing anything on the way, so that every
+ *   join can still be undone.
+ */
+int RollbackUnionFind::findRoot(int nodeNum) {
+    UnionFindIndex curr = nodeNum;
+    while (nodeParents[curr] != curr) {
+        curr = nodeParents[curr];
+    }
+    return curr;
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * File: RollbackUnionFind.h
+ *
+ * Eric Beach
+ *
+ * A UnionFind data structure (i.e., Disjoint-set data structure) whose joins
+ *   can be undone, for editing a maze one wall at a time.
+ * http://en.wikipedia.org/wiki/Disjoint-set_data_structure
+ */
+
+#ifndef __Trailblazer__RollbackUnionFind__
+#define __Trailblazer__RollbackUnionFind__
+
+#include "UnionFind.h"
+#include "vector.h"
+
+/*
+ * A version of UnionFind that keeps a log of its joins so that they can be
+ *   undone.  snapshot returns a marker for the current state, and
+ *   rollback(marker) undoes every join made since, most recent first, in
+ *   time proportional to the number of joins undone.  Snapshots nest: after
+ *   rolling back to one marker, any earlier marker is still valid, but later
+ *   markers are not.
+ *
+ * Undoing a join just means making the root that was linked a root again,
+ *   which only works if nothing else has changed since the join.  So unlike
+ *   UnionFind, find never shortens paths (no path compression); instead sets
+ *   are joined by rank (the root of the shallower tree becomes a child of
+ *   the root of the deeper one), which alone keeps every tree O(log n)
+ *   deep.
+ * makeSet is not logged; it is meant for setting up the structure before
+ *   taking any snapshots.
+ */
+class RollbackUnionFind {
+public:
+    // see UnionFind for the meaning of maxSetNum and numCols
+    RollbackUnionFind(const int maxSetNum, const int numCols);
+
+    // clean up class by deallocating used memory
+    ~RollbackUnionFind();
+
+    // Return the root location for a given location
+    Loc find(const Loc& toFind);
+
+    // Join two subsets into one; returns true if a merge happened
+    bool join(const Loc& a, const Loc& b);
+
+    // make a set (i.e., add a new element as a singleton set)
+    void makeSet(const Loc& input);
+
+    // The same operations on node numbers (row * numCols + col) rather
+    //   than Loc objects, as in UnionFind.
+    void makeSet(const int nodeNum);
+    int findIndex(const int nodeNum);
+    bool unite(const int a, const int b);
+    bool connected(const int a, const int b);
+
+    // Return a marker for the current state that can later be passed to
+    //   rollback
+    int snapshot();
+
+    // Undo every join made since the given snapshot was taken
+    void rollback(const int snapshot);
+
+private:
+    /*
+     * One entry in the log of joins: child is the root that was linked
+     *   under another root, and rankIncreased is whether that other root's
+     *   rank went up as a result.
+     */
+    struct JoinRecord {
+        UnionFindIndex child;
+        bool rankIncreased;
+    };
+
+    // array to store the parent nodes for each node
+    UnionFindIndex* nodeParents;
+
+    // array to store an upper bound on the height of each tree; only
+    //   meaningful for root nodes
+    unsigned char* nodeRanks;
+
+    // every successful join, in the order they happened
+    Vector<JoinRecord> joinLog;
+
+    // see UnionFind
+    int MAX_SET_NUM;
+    int NUM_COLS;
+
+    // report an error if nodeNum is not a valid node number
+    void checkNodeNum(const int nodeNum);
+
+    // find the root of nodeNum, which is assumed to be valid
+    int findRoot(int nodeNum);
+
+    // copying would share the arrays between two objects, so disallow it
+    RollbackUnionFind(const RollbackUnionFind& other);
+    RollbackUnionFind& operator=(const RollbackUnionFind& other);
+};
+
+#endif /* defined(__Trailblazer__RollbackUnionFind__) */
@@ -139,6 +139,45 @@ public:
    GridRow operator[](int row);
    const GridRow operator[](int row) const;
 
+/*
+ * Method: unchecked
+ * Usage: ValueType & value = grid.unchecked(row, col);
+ * ----------------------------------------------------
+ * Returns a reference to the element at the specified location, like
+ * <code>grid[row][col]</code> but without building a row object.  The
+ * indices are checked only when <code>NDEBUG</code> is not defined, so
+ * this is meant for inner loops that already keep their indices in
+ * range.
+ */
+
+   ValueType & unchecked(int row, int col);
+   const ValueType & unchecked(int row, int col) const;
+
+/*
+ * Method: rowData
+ * Usage: ValueType *rowStart = grid.rowData(row);
+ * -----------------------------------------------
+ * Returns a pointer to the first of the <code>numCols()</code> elements of
+ * the specified row, which are stored one after another.  As with
+ * <code>unchecked</code>, the row is checked only when <code>NDEBUG</code>
+ * is not defined.
+ */
+
+   ValueType *rowData(int row);
+   const ValueType *rowData(int row) const;
+
+/*
+ * Method: data
+ * Usage: ValueType *elements = grid.data();
+ * -----------------------------------------
+ * Returns a pointer to all of the elements, in row-major order, so that
+ * the element at (row, col) is <code>elements[row * numCols() + col]</code>.
+ * The pointer is valid until the grid is resized, assigned or swapped.
+ */
+
+   ValueType *data();
+   const ValueType *data() const;
+
 /*
  * Method: toString
  * Usage: string str = grid.toString();
@@ -164,6 +203,18 @@ public:
    template <typename FunctorType>
    void mapAll(FunctorType fn) const;
 
+/*
+ * Method: swap
+ * Usage: grid.swap(other);
+ * ------------------------
+ * Exchanges the contents of this grid with those of <code>other</code>
+ * in constant time, without copying any elements.  Swapping with a
+ * temporary, as in <code>makeGrid().swap(grid)</code>, hands a grid
+ * returned by value over without the deep copy that assignment makes.
+ */
+
+   void swap(Grid & other);
+
 /*
  * Additional Grid operations
  * --------------------------
@@ -404,6 +455,19 @@ void Grid<ValueType>::resize(int nRows, int nCols) {
    }
 }
 
+template <typename ValueType>
+void Grid<ValueType>::swap(Grid & other) {
+   ValueType *tempElements = elements;
+   elements = other.elements;
+   other.elements = tempElements;
+   int tempRows = nRows;
+   nRows = other.nRows;
+   other.nRows = tempRows;
+   int tempCols = nCols;
+   nCols = other.nCols;
+   other.nCols = tempCols;
+}
+
 template <typename ValueType>
 bool Grid<ValueType>::inBounds(int row, int col) const {
    return row >= 0 && col >= 0 && row < nRows && col < nCols;
@@ -427,6 +491,48 @@ void Grid<ValueType>::set(int row, int col, ValueType value) {
    elements[(row * nCols) + col] = value;
 }
 
+template <typename ValueType>
+ValueType & Grid<ValueType>::unchecked(int row, int col) {
+#ifndef NDEBUG
+   if (!inBounds(row, col)) error("unchecked: Grid indices out of bounds");
+#endif
+   return elements[(row * nCols) + col];
+}
+
+template <typename ValueType>
+const ValueType & Grid<ValueType>::unchecked(int row, int col) const {
+#ifndef NDEBUG
+   if (!inBounds(row, col)) error("unchecked: Grid indices out of bounds");
+#endif
+   return elements[(row * nCols) + col];
+}
+
+template <typename ValueType>
+ValueType *Grid<ValueType>::rowData(int row) {
+#ifndef NDEBUG
+   if (row < 0 || row >= nRows) error("rowData: Grid row out of bounds");
+#endif
+   return elements + row * nCols;
+}
+
+template <typename ValueType>
+const ValueType *Grid<ValueType>::rowData(int row) const {
+#ifndef NDEBUG
+   if (row < 0 || row >= nRows) error("rowData: Grid row out of bounds");
+#endif
+   return elements + row * nCols;
+}
+
+template <typename ValueType>
+ValueType *Grid<ValueType>::data() {
+   return elements;
+}
+
+template <typename ValueType>
+const ValueType *Grid<ValueType>::data() const {
+   return elements;
+}
+
 template <typename ValueType>
 typename Grid<ValueType>::GridRow Grid<ValueType>::operator[](int row) {
    return GridRow(this, row);
@@ -202,6 +202,16 @@ public:
    template <typename FunctorType>
    void mapAll(FunctorType fn) const;
 
+/*
+ * Method: swap
+ * Usage: vec.swap(other);
+ * -----------------------
+ * Exchanges the contents of this vector with those of <code>other</code>
+ * in constant time, without copying any elements.
+ */
+
+   void swap(Vector & other);
+
 /*
  * Additional Vector operations
  * ----------------------------
@@ -563,6 +573,19 @@ std::string Vector<ValueType>::toString() {
    return os.str();
 }
 
+template <typename ValueType>
+void Vector<ValueType>::swap(Vector & other) {
+   ValueType *tempElements = elements;
+   elements = other.elements;
+   other.elements = tempElements;
+   int tempCapacity = capacity;
+   capacity = other.capacity;
+   other.capacity = tempCapacity;
+   int tempCount = count;
+   count = other.count;
+   other.count = tempCount;
+}
+
 /*
  * Implementation notes: copy constructor and assignment operator
  * --------------------------------------------------------------
@@ -0,0 +1,234 @@
+/******************************************************************************
+ * File: TerrainChunks.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of chunked, seeded terrain generation and paging.
+ */
+
+#include "TerrainChunks.h"
+#include "FastRandom.h"
+#include "error.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+/* Constant: kNoiseOctaves
+ *
+ * The number of layers of noise added together, each with features half the
+ *   size of the one before.
+ */
+const int kNoiseOctaves = 7;
+
+/* Constant: kNoiseBasePeriod
+ *
+ * The spacing, in cells, of the lattice of the coarsest layer of noise.
+ */
+const double kNoiseBasePeriod = 128.0;
+
+/* Constant: kNoisePersistence
+ *
+ * How much weaker each layer is than the one before; like the shrink factor
+ *   of the diamond-square algorithm in WorldGenerator.cpp.
+ */
+const double kNoisePersistence = 0.7;
+
+/* Constant: kNoiseSpread
+ *
+ * The layers almost never line up to reach the largest sum they could, so
+ *   sums are scaled as if this fraction of it were the largest, and the rare
+ *   ones beyond it are clamped.  This spreads heights over about the same
+ *   range as the terrain generateRandomTerrain makes.
+ */
+const double kNoiseSpread = 0.5;
+
+/* Constant: kDiagonal
+ *
+ * The length of each side of a unit vector at 45 degrees.  This is also the
+ *   largest value one layer of gradient noise can reach.
+ */
+const double kDiagonal = 0.70710678118654752440;
+
+/* Function: latticeGradient
+ *
+ * Picks one of eight unit gradients for a lattice point of one layer, from
+ *   the layer's seed and the point alone.
+ */
+static void latticeGradient(uint64_t layerSeed, int x, int y,
+                            double& gradX, double& gradY) {
+    static const double kGradX[] = {
+        1, -1, 0, 0, kDiagonal, -kDiagonal, kDiagonal, -kDiagonal
+    };
+    static const double kGradY[] = {
+        0, 0, 1, -1, kDiagonal, kDiagonal, -kDiagonal, -kDiagonal
+    };
+    uint64_t bits = hashBits(hashBits(layerSeed + (uint32_t) x) +
+                             (uint32_t) y);
+    int index = int(bits >> 61);
+    gradX = kGradX[index];
+    gradY = kGradY[index];
+}
+
+/* Function: fade
+ *
+ * Perlin's smootherstep, 6t^5 - 15t^4 + 10t^3, which eases the blend between
+ *   lattice points so that the noise has no visible creases.
+ */
+static double fade(double t) {
+    return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+/* Function: gradientNoise
+ *
+ * Returns one layer of gradient noise at (x, y), in lattice units: the
+ *   contributions of the gradients at the four surrounding lattice points,
+ *   blended together.  The result is in [-kDiagonal, kDiagonal].
+ */
+static double gradientNoise(uint64_t layerSeed, double x, double y) {
+    double cellX = floor(x);
+    double cellY = floor(y);
+    int x0 = int(cellX);
+    int y0 = int(cellY);
+    double dx = x - cellX;
+    double dy = y - cellY;
+
+    double corners[4];
+    for (int i = 0; i < 4; i++) {
+        int cornerX = i % 2;
+        int cornerY = i / 2;
+        double gradX, gradY;
+        latticeGradient(layerSeed, x0 + cornerX, y0 + cornerY, gradX, gradY);
+        corners[i] = gradX * (dx - cornerX) + gradY * (dy - cornerY);
+    }
+    double blendX = fade(dx);
+    double top = corners[0] + blendX * (corners[1] - corners[0]);
+    double bottom = corners[2] + blendX * (corners[3] - corners[2]);
+    return top + fade(dy) * (bottom - top);
+}
+
+/* Function: terrainHeight
+ *
+ * Returns the height at a world location: all the layers of noise added
+ *   together, scaled into [0, 1] and then squared, which (as with
+ *   generateRandomTerrain) depresses the valleys and sharpens the peaks.
+ */
+static double terrainHeight(uint64_t worldSeed, int row, int col) {
+    double sum = 0.0;
+    double maxSum = 0.0;
+    double amplitude = 1.0;
+    double period = kNoiseBasePeriod;
+    for (int layer = 0; layer < kNoiseOctaves; layer++) {
+        uint64_t layerSeed = hashBits(worldSeed + layer);
+        sum += amplitude * gradientNoise(layerSeed, col / period, row / period);
+        maxSum += amplitude * kDiagonal;
+        amplitude *= kNoisePersistence;
+        period /= 2.0;
+    }
+    double height = 0.5 + 0.5 * sum / (kNoiseSpread * maxSum);
+    height = max(0.0, min(1.0, height));
+    return height * height;
+}
+
+/* Function: floorDivide
+ *
+ * Divides, rounding down rather than toward zero, so that negative world
+ *   locations land in the right chunk.
+ */
+static int floorDivide(int value, int divisor) {
+    int quotient = value / divisor;
+    if (value % divisor != 0 && value < 0) quotient--;
+    return quotient;
+}
+
+Grid<double> generateTerrainChunk(uint64_t worldSeed, int chunkRow,
+                                  int chunkCol) {
+    Grid<double> heights(kTerrainChunkSize, kTerrainChunkSize);
+    int top = chunkRow * kTerrainChunkSize;
+    int left = chunkCol * kTerrainChunkSize;
+    for (int row = 0; row < kTerrainChunkSize; row++) {
+        double* rowHeights = heights.rowData(row);
+        for (int col = 0; col < kTerrainChunkSize; col++) {
+            rowHeights[col] = terrainHeight(worldSeed, top + row, left + col);
+        }
+    }
+    return heights;
+}
+
+TerrainPager::TerrainPager(uint64_t worldSeed, int maxChunks) {
+    if (maxChunks < 1) error("A terrain pager must hold at least one chunk.");
+    this->worldSeed = worldSeed;
+    this->maxChunks = maxChunks;
+    useCount = 0;
+}
+
+double TerrainPager::height(int row, int col) {
+    int chunkRow = floorDivide(row, kTerrainChunkSize);
+    int chunkCol = floorDivide(col, kTerrainChunkSize);
+    return chunk(chunkRow, chunkCol)[row - chunkRow * kTerrainChunkSize]
+                                    [col - chunkCol * kTerrainChunkSize];
+}
+
+/*
+ * Copy the region over a chunk at a time, so that each chunk is looked up
+ *   once however many of its cells are used.
+ */
+Grid<double> TerrainPager::region(int top, int left,
+                                  int numRows, int numCols) {
+    Grid<double> result(numRows, numCols);
+    if (numRows == 0 || numCols == 0) return result;
+    int firstChunkRow = floorDivide(top, kTerrainChunkSize);
+    int lastChunkRow = floorDivide(top + numRows - 1, kTerrainChunkSize);
+    int firstChunkCol = floorDivide(left, kTerrainChunkSize);
+    int lastChunkCol = floorDivide(left + numCols - 1, kTerrainChunkSize);
+    for (int chunkRow = firstChunkRow; chunkRow <= lastChunkRow; chunkRow++) {
+        for (int chunkCol = firstChunkCol; chunkCol <= lastChunkCol;
+             chunkCol++) {
+            Grid<double>& heights = chunk(chunkRow, chunkCol);
+            int chunkTop = chunkRow * kTerrainChunkSize;
+            int chunkLeft = chunkCol * kTerrainChunkSize;
+            int startRow = max(top, chunkTop);
+            int endRow = min(top + numRows, chunkTop + kTerrainChunkSize);
+            int startCol = max(left, chunkLeft);
+            int endCol = min(left + numCols, chunkLeft + kTerrainChunkSize);
+            for (int row = startRow; row < endRow; row++) {
+                const double* source = heights.rowData(row - chunkTop);
+                double* dest = result.rowData(row - top);
+                for (int col = startCol; col < endCol; col++) {
+                    dest[col - left] = source[col - chunkLeft];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+int TerrainPager::numLoadedChunks() const {
+    return int(chunks.size());
+}
+
+////////// PRIVATE METHODS //////////
+Grid<double>& TerrainPager::chunk(int chunkRow, int chunkCol) {
+    useCount++;
+    pair<int, int> key(chunkRow, chunkCol);
+    map<pair<int, int>, Chunk>::iterator found = chunks.find(key);
+    if (found != chunks.end()) {
+        found->second.lastUsed = useCount;
+        return found->second.heights;
+    }
+
+    // make room by dropping the chunk that has gone unused the longest
+    if (int(chunks.size()) >= maxChunks) {
+        map<pair<int, int>, Chunk>::iterator oldest = chunks.begin();
+        for (map<pair<int, int>, Chunk>::iterator it = chunks.begin();
+             it != chunks.end(); ++it) {
+            if (it->second.lastUsed < oldest->second.lastUsed) oldest = it;
+        }
+        chunks.erase(oldest);
+    }
+
+    Chunk& added = chunks[key];
+    generateTerrainChunk(worldSeed, chunkRow, chunkCol).swap(added.heights);
+    added.lastUsed = useCount;
+    return added.heights;
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * File: TerrainChunks.h
+ *
+ * Eric Beach
+ *
+ * Terrain for worlds too big to generate all at once.  generateRandomTerrain
+ *   builds the whole grid in one go, since the diamond-square algorithm
+ *   needs every coarser level in place before the next one; here every
+ *   height is a function of a world seed and its location alone (fractal
+ *   gradient noise), so the world is cut into chunks that can each be
+ *   generated on their own, in any order, and only when needed.
+ * http://en.wikipedia.org/wiki/Perlin_noise
+ */
+
+#ifndef __Trailblazer__TerrainChunks__
+#define __Trailblazer__TerrainChunks__
+
+#include "grid.h"
+#include <map>
+#include <stdint.h>
+#include <utility>
+
+/* Constant: kTerrainChunkSize
+ *
+ * The number of rows and of columns in a chunk.
+ */
+const int kTerrainChunkSize = 128;
+
+/* Function: generateTerrainChunk
+ *
+ * Generates the heights (all in [0, 1]) of the chunk at (chunkRow, chunkCol),
+ *   which covers world rows chunkRow * kTerrainChunkSize onward and world
+ *   columns chunkCol * kTerrainChunkSize onward.  Chunk coordinates may be
+ *   negative; the world goes on in every direction.  The same seed and
+ *   chunk always give the same heights, and neighboring chunks line up
+ *   seamlessly however and whenever they are generated.
+ */
+Grid<double> generateTerrainChunk(uint64_t worldSeed, int chunkRow,
+                                  int chunkCol);
+
+/*
+ * Pages the chunks of a world in as they are used, keeping the most recently
+ *   used ones in memory.  A search over part of a huge world only ever
+ *   generates the chunks around the area it touches.
+ */
+class TerrainPager {
+public:
+    // page chunks of the world with the given seed, keeping at most
+    //   maxChunks of them in memory
+    TerrainPager(uint64_t worldSeed, int maxChunks = 64);
+
+    // return the height at a location in the world, generating its chunk
+    //   if it isn't in memory
+    double height(int row, int col);
+
+    // return the numRows x numCols part of the world whose top left corner
+    //   is at (top, left), e.g., to run shortestPath on
+    Grid<double> region(int top, int left, int numRows, int numCols);
+
+    // return the number of chunks currently in memory
+    int numLoadedChunks() const;
+
+private:
+    struct Chunk {
+        Grid<double> heights;
+        long long lastUsed;
+    };
+
+    uint64_t worldSeed;
+    int maxChunks;
+
+    // chunks in memory, by (chunkRow, chunkCol)
+    std::map<std::pair<int, int>, Chunk> chunks;
+
+    // counts chunk lookups, to find the least recently used chunk
+    long long useCount;
+
+    // return the chunk at (chunkRow, chunkCol), generating it (and
+    //   dropping the least recently used chunk to make room) if needed
+    Grid<double>& chunk(int chunkRow, int chunkCol);
+};
+
+#endif /* defined(__Trailblazer__TerrainChunks__) */
@@ -0,0 +1,283 @@
+/******************************************************************************
+ * File: TerrainPyramid.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of the terrain pyramid and coarse-to-fine search.
+ */
+
+#include "TerrainPyramid.h"
+#include "GridSearch.h"
+#include "TrailblazerConstants.h"
+#include "TrailblazerCosts.h"
+#include "error.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+/*
+ * The blocks of one level the full resolution search may use.  Each is given
+ *   a slot, and the marks of its cells are stored together in that slot, so
+ *   this is also the search's mark store (see gridAStar).
+ */
+struct Corridor {
+    int numRows;
+    int numCols;
+    int level;
+    int blockSize;
+    int coarseCols;
+
+    // the slot of each block of the level, or -1 if the block is outside
+    //   the corridor
+    vector<int> blockSlots;
+    int numSlots;
+
+    // the marks of the cells of every slot, slot by slot
+    vector<unsigned char> marks;
+
+    // return the mark of a cell, or NULL if the cell is outside the world
+    //   or the corridor
+    unsigned char* mark(Loc loc);
+};
+
+TerrainPyramid::TerrainPyramid(Grid<double>& world) {
+    int rows = world.numRows();
+    int cols = world.numCols();
+    while (rows > 1 || cols > 1) {
+        levels.resize(levels.size() + 1);
+        Level& next = levels.back();
+        next.rows = (rows + 1) / 2;
+        next.cols = (cols + 1) / 2;
+        next.minHeights.assign(next.rows * next.cols, HUGE_VAL);
+        next.maxHeights.assign(next.rows * next.cols, -HUGE_VAL);
+
+        // fold each cell (or block) of the level below into the block
+        //   that covers it
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                double low, high;
+                if (levels.size() == 1) {
+                    low = high = world.unchecked(row, col);
+                } else {
+                    const Level& prev = levels[levels.size() - 2];
+                    low = prev.minHeights[row * cols + col];
+                    high = prev.maxHeights[row * cols + col];
+                }
+                int index = (row / 2) * next.cols + col / 2;
+                next.minHeights[index] = min(next.minHeights[index], low);
+                next.maxHeights[index] = max(next.maxHeights[index], high);
+            }
+        }
+        rows = next.rows;
+        cols = next.cols;
+    }
+}
+
+int TerrainPyramid::numLevels() const {
+    return int(levels.size()) + 1;
+}
+
+int TerrainPyramid::numRows(int level) const {
+    if (level < 1 || level >= numLevels()) {
+        error("Pyramid level is out of range.");
+    }
+    return levels[level - 1].rows;
+}
+
+int TerrainPyramid::numCols(int level) const {
+    if (level < 1 || level >= numLevels()) {
+        error("Pyramid level is out of range.");
+    }
+    return levels[level - 1].cols;
+}
+
+double TerrainPyramid::minHeight(int level, int row, int col) const {
+    return levels[level - 1].minHeights[blockIndex(level, row, col)];
+}
+
+double TerrainPyramid::maxHeight(int level, int row, int col) const {
+    return levels[level - 1].maxHeights[blockIndex(level, row, col)];
+}
+
+////////// PRIVATE METHODS //////////
+int TerrainPyramid::blockIndex(int level, int row, int col) const {
+    if (row < 0 || row >= numRows(level) || col < 0 || col >= numCols(level)) {
+        error("Pyramid location is out of range.");
+    }
+    return row * levels[level - 1].cols + col;
+}
+
+/* Function: heightGap
+ *
+ * Returns the least change in height any step from a cell of one block to a
+ *   cell of the other could make: zero if their height ranges overlap, and
+ *   the distance between the ranges otherwise.
+ */
+static double heightGap(const TerrainPyramid& pyramid, int level,
+                        Loc from, Loc to) {
+    double fromLow = pyramid.minHeight(level, from.row, from.col);
+    double fromHigh = pyramid.maxHeight(level, from.row, from.col);
+    double toLow = pyramid.minHeight(level, to.row, to.col);
+    double toHigh = pyramid.maxHeight(level, to.row, to.col);
+    return max(0.0, max(toLow - fromHigh, fromLow - toHigh));
+}
+
+/* Function: blockDistance
+ *
+ * Returns the distance between the centers of two blocks of a level, in
+ *   cells.  This is also the coarse search's heuristic, which the cost of
+ *   every move between blocks is at least, so the heuristic is consistent.
+ */
+static double blockDistance(int blockSize, Loc from, Loc to) {
+    int drow = to.row - from.row;
+    int dcol = to.col - from.col;
+    return blockSize * sqrt(double(drow * drow + dcol * dcol));
+}
+
+/*
+ * The costs of the coarse search's steps between neighboring blocks of a
+ *   level, as described in TerrainPyramid.h.
+ */
+struct BlockMoves {
+    static const bool kDiagonalSteps = true;
+
+    const TerrainPyramid& pyramid;
+    int level;
+    int blockSize;
+    Loc endBlock;
+
+    BlockMoves(const TerrainPyramid& pyramid, int level, Loc endBlock)
+        : pyramid(pyramid), level(level), blockSize(1 << level),
+          endBlock(endBlock) {}
+
+    double cost(Loc from, Loc to) {
+        return blockDistance(blockSize, from, to) +
+            kAltitudePenalty * heightGap(pyramid, level, from, to);
+    }
+    double heuristic(Loc loc) {
+        return blockDistance(blockSize, loc, endBlock);
+    }
+};
+
+/* Function: findBlockRoute
+ *
+ * A* search over the blocks of a level, from the block holding start to the
+ *   one holding end.  Returns the blocks along the route.  Every block is
+ *   reachable from every other, so this always finds one.
+ */
+static Vector<Loc> findBlockRoute(Loc start, Loc end,
+                                  const TerrainPyramid& pyramid, int level) {
+    Loc startBlock = makeLoc(start.row >> level, start.col >> level);
+    Loc endBlock = makeLoc(end.row >> level, end.col >> level);
+    GridMarks marks(pyramid.numRows(level), pyramid.numCols(level));
+    BlockMoves moves(pyramid, level, endBlock);
+    return gridAStar(startBlock, endBlock, marks, moves);
+}
+
+/* Function: buildCorridor
+ *
+ * Gives a slot to every block within margin blocks of the route, and an
+ *   unvisited mark to every cell of those blocks.
+ */
+static void buildCorridor(const Vector<Loc>& route, Grid<double>& world,
+                          const TerrainPyramid& pyramid, int level,
+                          int margin, Corridor& corridor) {
+    int coarseRows = pyramid.numRows(level);
+    corridor.numRows = world.numRows();
+    corridor.numCols = world.numCols();
+    corridor.level = level;
+    corridor.blockSize = 1 << level;
+    corridor.coarseCols = pyramid.numCols(level);
+    corridor.blockSlots.assign(coarseRows * corridor.coarseCols, -1);
+    corridor.numSlots = 0;
+    for (int i = 0; i < route.size(); i++) {
+        int firstRow = max(0, route[i].row - margin);
+        int lastRow = min(coarseRows - 1, route[i].row + margin);
+        int firstCol = max(0, route[i].col - margin);
+        int lastCol = min(corridor.coarseCols - 1, route[i].col + margin);
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int col = firstCol; col <= lastCol; col++) {
+                int& slot =
+                    corridor.blockSlots[row * corridor.coarseCols + col];
+                if (slot == -1) slot = corridor.numSlots++;
+            }
+        }
+    }
+    corridor.marks.assign(corridor.numSlots * corridor.blockSize *
+                          corridor.blockSize, kUnvisitedCell);
+}
+
+unsigned char* Corridor::mark(Loc loc) {
+    if (loc.row < 0 || loc.row >= numRows ||
+        loc.col < 0 || loc.col >= numCols) {
+        return NULL;
+    }
+    int slot = blockSlots[(loc.row >> level) * coarseCols + (loc.col >> level)];
+    if (slot == -1) return NULL;
+    int mask = blockSize - 1;
+    return &marks[(slot * blockSize + (loc.row & mask)) * blockSize +
+                  (loc.col & mask)];
+}
+
+/*
+ * The costs of the full resolution search's steps, by terrainCost.
+ */
+struct WorldMoves {
+    static const bool kDiagonalSteps = true;
+
+    Grid<double>& world;
+    Loc end;
+
+    WorldMoves(Grid<double>& world, Loc end) : world(world), end(end) {}
+
+    double cost(Loc from, Loc to) {
+        return terrainCost(from, to, world);
+    }
+    double heuristic(Loc loc) {
+        return terrainHeuristic(loc, end, world);
+    }
+};
+
+Vector<Loc> coarseToFinePath(Loc start, Loc end, Grid<double>& world,
+                             const TerrainPyramid& pyramid) {
+    int level = 1;
+    while (level < pyramid.numLevels() - 1 &&
+           pyramid.numRows(level) * pyramid.numCols(level) >
+           kMaxCoarseSearchCells) {
+        level++;
+    }
+    return coarseToFinePath(start, end, world, pyramid, level,
+                            kDefaultCorridorMargin);
+}
+
+Vector<Loc> coarseToFinePath(Loc start, Loc end, Grid<double>& world,
+                             const TerrainPyramid& pyramid,
+                             int level, int margin) {
+    if (!world.inBounds(start.row, start.col) ||
+        !world.inBounds(end.row, end.col)) {
+        error("Terrain location is out of range.");
+    }
+    Vector<Loc> path;
+    if (start == end) {
+        path += start;
+        return path;
+    }
+    if (level < 1 || level >= pyramid.numLevels()) {
+        error("Pyramid level is out of range.");
+    }
+    if (margin < 0) error("Corridor margin must not be negative.");
+    if (pyramid.numRows(level) != ((world.numRows() - 1) >> level) + 1 ||
+        pyramid.numCols(level) != ((world.numCols() - 1) >> level) + 1) {
+        error("The pyramid was not built from this world.");
+    }
+
+    // A* at full resolution, as in shortestPath, but over the corridor's
+    //   cells only; the corridor is a connected run of blocks holding start
+    //   and end, so there is always a path through it
+    Corridor corridor;
+    buildCorridor(findBlockRoute(start, end, pyramid, level), world, pyramid,
+                  level, margin, corridor);
+    WorldMoves moves(world, end);
+    return gridAStar(start, end, corridor, moves);
+}
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * File: TerrainPyramid.h
+ *
+ * Eric Beach
+ *
+ * Coarse-to-fine search for very large terrains.  A TerrainPyramid keeps,
+ *   for blocks of 2 x 2, 4 x 4, 8 x 8, ... cells, the lowest and highest
+ *   height in each block.  coarseToFinePath first plans a route over the
+ *   blocks of one level, then searches at full resolution only inside a
+ *   corridor of blocks around that route, so a search of a 10k x 10k world
+ *   touches a thin strip of it rather than all 100 million cells.
+ */
+
+#ifndef __Trailblazer__TerrainPyramid__
+#define __Trailblazer__TerrainPyramid__
+
+#include "TrailblazerTypes.h"
+#include "grid.h"
+#include "vector.h"
+#include <vector>
+
+/* Constant: kMaxCoarseSearchCells
+ *
+ * coarseToFinePath plans its route on the finest level of the pyramid that
+ *   has at most this many blocks, which keeps the coarse search cheap.
+ */
+const int kMaxCoarseSearchCells = 65536;
+
+/* Constant: kDefaultCorridorMargin
+ *
+ * The number of blocks on each side of the coarse route that the full
+ *   resolution search may also use.
+ */
+const int kDefaultCorridorMargin = 1;
+
+/*
+ * The height bounds of a terrain at successively coarser resolutions.  Level
+ *   0 is the terrain itself and isn't stored; each block of level k covers
+ *   2^k x 2^k cells (fewer along the bottom and right edges), and its bounds
+ *   are those of the four level k - 1 blocks it covers, so they hold
+ *   exactly the lowest and highest height in the block.
+ */
+class TerrainPyramid {
+public:
+    // build the pyramid of a terrain world, up to the level that is a
+    //   single block
+    TerrainPyramid(Grid<double>& world);
+
+    // return the number of levels, counting level 0
+    int numLevels() const;
+
+    // return the number of block rows / columns at a level from 1 to
+    //   numLevels() - 1
+    int numRows(int level) const;
+    int numCols(int level) const;
+
+    // return the lowest / highest height in the block at (row, col) of a
+    //   level from 1 to numLevels() - 1
+    double minHeight(int level, int row, int col) const;
+    double maxHeight(int level, int row, int col) const;
+
+private:
+    struct Level {
+        int rows;
+        int cols;
+        std::vector<double> minHeights;
+        std::vector<double> maxHeights;
+    };
+
+    // levels 1 and up; level k is stored at index k - 1
+    std::vector<Level> levels;
+
+    // return the index of a block in its level's vectors, checking bounds
+    int blockIndex(int level, int row, int col) const;
+};
+
+/* Function: coarseToFinePath
+ *
+ * Finds a cheap path (under terrainCost) between two locations of a terrain
+ *   in two passes.  The first finds the cheapest route between their blocks
+ *   on one level of the pyramid.  Moving to a neighboring block costs the
+ *   distance between block centers plus kAltitudePenalty times the least
+ *   climb any step between the two blocks could make, which the height
+ *   bounds give; the climb is never overstated, so a block a path could
+ *   cross on the level is never ruled out for being steep.  The second
+ *   pass is A* search with terrainCost and terrainHeuristic at full
+ *   resolution, limited to the blocks within margin blocks of the route.
+ * The path is the cheapest one inside the corridor, which is usually, but
+ *   not always, the cheapest path overall.  The version without a level
+ *   uses the finest level with at most kMaxCoarseSearchCells blocks, and
+ *   kDefaultCorridorMargin.
+ */
+Vector<Loc> coarseToFinePath(Loc start, Loc end, Grid<double>& world,
+                             const TerrainPyramid& pyramid);
+Vector<Loc> coarseToFinePath(Loc start, Loc end, Grid<double>& world,
+                             const TerrainPyramid& pyramid,
+                             int level, int margin);
+
+#endif /* defined(__Trailblazer__TerrainPyramid__) */
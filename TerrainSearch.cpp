@@ -0,0 +1,45 @@
+/******************************************************************************
+ * File: TerrainSearch.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of shortest path search on a Heightfield.
+ */
+
+#include "TerrainSearch.h"
+#include "GridSearch.h"
+#include "TrailblazerCosts.h"
+#include "error.h"
+
+using namespace std;
+
+/*
+ * The costs of the search's steps, by terrainCost over the heightfield.
+ */
+struct HeightfieldMoves {
+    static const bool kDiagonalSteps = true;
+
+    const Heightfield& heights;
+    Loc end;
+
+    HeightfieldMoves(const Heightfield& heights, Loc end)
+        : heights(heights), end(end) {}
+
+    double cost(Loc from, Loc to) {
+        return terrainCost(from, to, heights);
+    }
+    double heuristic(Loc loc) {
+        return terrainHeuristic(loc, end, heights);
+    }
+};
+
+Vector<Loc> shortestTerrainPath(Loc start, Loc end,
+                                const Heightfield& heights) {
+    if (!heights.inBounds(start.row, start.col) ||
+        !heights.inBounds(end.row, end.col)) {
+        error("Terrain location is out of range.");
+    }
+    GridMarks marks(heights.numRows(), heights.numCols());
+    HeightfieldMoves moves(heights, end);
+    return gridAStar(start, end, marks, moves);
+}
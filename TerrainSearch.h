@@ -0,0 +1,32 @@
+/******************************************************************************
+ * File: TerrainSearch.h
+ *
+ * Eric Beach
+ *
+ * Shortest path search run directly on a Heightfield, rather than on a
+ *   Grid<double> terrain world.  With quantized heights, the heights and the
+ *   search's own state together take 3 bytes per cell, where the world alone
+ *   takes 8 (see Heightfield.h for what the cheaper heights cost in
+ *   accuracy).
+ */
+
+#ifndef __Trailblazer__TerrainSearch__
+#define __Trailblazer__TerrainSearch__
+
+#include "TrailblazerTypes.h"
+#include "Heightfield.h"
+#include "vector.h"
+
+/* Function: shortestTerrainPath
+ *
+ * Finds the cheapest path between two locations of a heightfield, moving to
+ *   any of the eight neighbors of a cell at each step, and returns the
+ *   locations to visit in order.  This is A* search with terrainCost and
+ *   terrainHeuristic over the heightfield; it keeps one byte of state per
+ *   cell besides the heights.  The path is the cheapest for the heights as
+ *   stored, which shortestPath over heights.toGrid() would also find.
+ * If no path is found, this function reports an error.
+ */
+Vector<Loc> shortestTerrainPath(Loc start, Loc end, const Heightfield& heights);
+
+#endif /* defined(__Trailblazer__TerrainSearch__) */
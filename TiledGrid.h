@@ -0,0 +1,192 @@
+/******************************************************************************
+ * File: TiledGrid.h
+ *
+ * Eric Beach
+ *
+ * A grid stored in square tiles rather than row by row.  Grid stores each
+ *   row after the one above it, so the three rows an 8-neighbor expansion
+ *   touches are a whole row apart in memory, and a walk down a column of a
+ *   big terrain lands on a new cache line at every step.  A TiledGrid stores
+ *   each 8 x 8 tile of cells together (the tiles themselves row by row), so
+ *   nearby cells in any direction are usually in the same few cache lines.
+ *   It offers the same (row, col) interface as Grid.
+ * http://en.wikipedia.org/wiki/Locality_of_reference
+ */
+
+#ifndef __Trailblazer__TiledGrid__
+#define __Trailblazer__TiledGrid__
+
+#include "grid.h"
+#include "error.h"
+#include <algorithm>
+#include <vector>
+
+/* Constant: kGridTileShift
+ *
+ * Tiles are 2^kGridTileShift cells on a side.
+ */
+const int kGridTileShift = 3;
+const int kGridTileSize = 1 << kGridTileShift;
+const int kGridTileMask = kGridTileSize - 1;
+
+/*
+ * A numRows x numCols grid of values, stored tile by tile.  ValueType must
+ *   not be bool (std::vector<bool> can't hand out references).
+ */
+template <typename ValueType>
+class TiledGrid {
+public:
+    // create an empty grid, or one whose values are all ValueType()
+    TiledGrid();
+    TiledGrid(int numRows, int numCols);
+
+    // create a grid holding a copy of the values of a Grid
+    TiledGrid(const Grid<ValueType>& grid);
+
+    int numRows() const;
+    int numCols() const;
+
+    // change the size of the grid, setting every value to ValueType()
+    void resize(int numRows, int numCols);
+
+    // return whether (row, col) is inside the grid
+    bool inBounds(int row, int col) const;
+
+    // return / change the value at (row, col), reporting an error if it is
+    //   out of bounds
+    ValueType get(int row, int col) const;
+    void set(int row, int col, const ValueType& value);
+
+    // return a reference to the value at (row, col); as with
+    //   Grid::unchecked, bounds are only checked when NDEBUG isn't defined
+    ValueType& unchecked(int row, int col);
+    const ValueType& unchecked(int row, int col) const;
+
+    // return the values as a Grid
+    Grid<ValueType> toGrid() const;
+
+    // exchange the contents of two grids without copying any values
+    void swap(TiledGrid& other);
+
+private:
+    int rows;
+    int cols;
+    int tilesPerRow;
+
+    // the tiles one after another, each holding its cells row by row; the
+    //   tiles along the bottom and right edges are padded out to full size
+    std::vector<ValueType> elements;
+
+    // return the index of (row, col) in elements
+    int cellIndex(int row, int col) const;
+};
+
+////////// IMPLEMENTATION //////////
+template <typename ValueType>
+TiledGrid<ValueType>::TiledGrid() {
+    rows = 0;
+    cols = 0;
+    tilesPerRow = 0;
+}
+
+template <typename ValueType>
+TiledGrid<ValueType>::TiledGrid(int numRows, int numCols) {
+    resize(numRows, numCols);
+}
+
+template <typename ValueType>
+TiledGrid<ValueType>::TiledGrid(const Grid<ValueType>& grid) {
+    resize(grid.numRows(), grid.numCols());
+    for (int row = 0; row < rows; row++) {
+        const ValueType* rowValues = grid.rowData(row);
+        for (int col = 0; col < cols; col++) {
+            elements[cellIndex(row, col)] = rowValues[col];
+        }
+    }
+}
+
+template <typename ValueType>
+int TiledGrid<ValueType>::numRows() const {
+    return rows;
+}
+
+template <typename ValueType>
+int TiledGrid<ValueType>::numCols() const {
+    return cols;
+}
+
+template <typename ValueType>
+void TiledGrid<ValueType>::resize(int numRows, int numCols) {
+    if (numRows < 0 || numCols < 0) {
+        error("TiledGrid size must not be negative.");
+    }
+    rows = numRows;
+    cols = numCols;
+    tilesPerRow = (numCols + kGridTileMask) >> kGridTileShift;
+    int tilesPerCol = (numRows + kGridTileMask) >> kGridTileShift;
+    elements.assign(tilesPerRow * tilesPerCol * kGridTileSize * kGridTileSize,
+                    ValueType());
+}
+
+template <typename ValueType>
+bool TiledGrid<ValueType>::inBounds(int row, int col) const {
+    return row >= 0 && row < rows && col >= 0 && col < cols;
+}
+
+template <typename ValueType>
+ValueType TiledGrid<ValueType>::get(int row, int col) const {
+    if (!inBounds(row, col)) error("TiledGrid location is out of range.");
+    return elements[cellIndex(row, col)];
+}
+
+template <typename ValueType>
+void TiledGrid<ValueType>::set(int row, int col, const ValueType& value) {
+    if (!inBounds(row, col)) error("TiledGrid location is out of range.");
+    elements[cellIndex(row, col)] = value;
+}
+
+template <typename ValueType>
+ValueType& TiledGrid<ValueType>::unchecked(int row, int col) {
+#ifndef NDEBUG
+    if (!inBounds(row, col)) error("TiledGrid location is out of range.");
+#endif
+    return elements[cellIndex(row, col)];
+}
+
+template <typename ValueType>
+const ValueType& TiledGrid<ValueType>::unchecked(int row, int col) const {
+#ifndef NDEBUG
+    if (!inBounds(row, col)) error("TiledGrid location is out of range.");
+#endif
+    return elements[cellIndex(row, col)];
+}
+
+template <typename ValueType>
+Grid<ValueType> TiledGrid<ValueType>::toGrid() const {
+    Grid<ValueType> result(rows, cols);
+    for (int row = 0; row < rows; row++) {
+        ValueType* rowValues = result.rowData(row);
+        for (int col = 0; col < cols; col++) {
+            rowValues[col] = elements[cellIndex(row, col)];
+        }
+    }
+    return result;
+}
+
+template <typename ValueType>
+void TiledGrid<ValueType>::swap(TiledGrid& other) {
+    std::swap(rows, other.rows);
+    std::swap(cols, other.cols);
+    std::swap(tilesPerRow, other.tilesPerRow);
+    elements.swap(other.elements);
+}
+
+////////// PRIVATE METHODS //////////
+template <typename ValueType>
+int TiledGrid<ValueType>::cellIndex(int row, int col) const {
+    int tile = (row >> kGridTileShift) * tilesPerRow + (col >> kGridTileShift);
+    return (((tile << kGridTileShift) + (row & kGridTileMask))
+            << kGridTileShift) + (col & kGridTileMask);
+}
+
+#endif /* defined(__Trailblazer__TiledGrid__) */
@@ -0,0 +1,185 @@
+/******************************************************************************
+ * File: TiledMaze.cpp
+ *
+ * Eric Beach
+ *
+ * Implementation of parallel, tiled maze generation.
+ */
+
+#include "TiledMaze.h"
+#include "FastRandom.h"
+#include "Parallel.h"
+#include "UnionFind.h"
+#include "error.h"
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+/*
+ * The state shared by all of the threads building tiles.  Each tile's tree
+ *   edges go into a list of its own (numbered as in createPackedMaze:
+ *   2 * node number of the upper / left cell, plus 1 for a down edge)
+ *   rather than straight into the PackedMaze, because the bytes of a
+ *   PackedMaze are shared by neighboring cells, and so by neighboring tiles.
+ */
+struct TiledMazeState {
+    int numRows;
+    int numCols;
+    int tileSize;
+    int numTileCols;
+    uint64_t seed;
+    vector< vector<int> > tileEdges;
+};
+
+/* Function: buildTile
+ *
+ * Build a maze within one tile with Kruskal's algorithm, working in node
+ *   numbers local to the tile, and record its edges.
+ */
+static void buildTile(TiledMazeState* state, int tileNum) {
+    int top = (tileNum / state->numTileCols) * state->tileSize;
+    int left = (tileNum % state->numTileCols) * state->tileSize;
+    int height = min(state->tileSize, state->numRows - top);
+    int width = min(state->tileSize, state->numCols - left);
+    int numCells = height * width;
+
+    // STEP 1: Construct the edges inside the tile and shuffle them
+    vector<int> edges;
+    edges.reserve(height * (width - 1) + (height - 1) * width);
+    for (int row = 0; row < height; row++) {
+        for (int col = 0; col < width; col++) {
+            int nodeNum = row * width + col;
+            if (col < width - 1) edges.push_back(2 * nodeNum);
+            if (row < height - 1) edges.push_back(2 * nodeNum + 1);
+        }
+    }
+    FastRandom random(state->seed, tileNum);
+    for (int i = int(edges.size()) - 1; i > 0; i--) {
+        swap(edges[i], edges[random.nextInt(i + 1)]);
+    }
+
+    // STEP 2: Kruskal's algorithm, translating the edges it keeps back to
+    //         node numbers of the whole maze
+    vector<int>& result = state->tileEdges[tileNum];
+    result.reserve(numCells - 1);
+    UnionFind clusters(numCells, width);
+    for (int nodeNum = 0; nodeNum < numCells; nodeNum++) {
+        clusters.makeSet(nodeNum);
+    }
+    for (int i = 0; i < int(edges.size()) &&
+                    int(result.size()) < numCells - 1; i++) {
+        int nodeNum = edges[i] / 2;
+        bool isDown = edges[i] % 2 == 1;
+        int neighborNum = isDown ? nodeNum + width : nodeNum + 1;
+        if (clusters.unite(nodeNum, neighborNum)) {
+            int mazeNum = (top + nodeNum / width) * state->numCols +
+                          left + nodeNum % width;
+            result.push_back(2 * mazeNum + (isDown ? 1 : 0));
+        }
+    }
+}
+
+/*
+ * parallelFor body: build the tiles in [begin, end).
+ */
+static void buildTiles(int begin, int end, void* data) {
+    TiledMazeState* state = (TiledMazeState*) data;
+    for (int tileNum = begin; tileNum < end; tileNum++) {
+        buildTile(state, tileNum);
+    }
+}
+
+/* Function: openPassage
+ *
+ * Open the passage for an edge numbered as in TiledMazeState.
+ */
+static void openPassage(PackedMaze& maze, int edge) {
+    int nodeNum = edge / 2;
+    int row = nodeNum / maze.numCols();
+    int col = nodeNum % maze.numCols();
+    if (edge % 2 == 1) {
+        maze.setDownPassage(row, col, true);
+    } else {
+        maze.setRightPassage(row, col, true);
+    }
+}
+
+PackedMaze createTiledMaze(int numRows, int numCols) {
+    FastRandom random;
+    uint64_t seed = ((uint64_t) random.nextBits() << 32) | random.nextBits();
+    return createTiledMaze(numRows, numCols, kDefaultMazeTileSize, seed);
+}
+
+/*
+ * Every tile's maze is a spanning tree of the tile, so the tiles can be
+ *   treated as single nodes for the final pass: Kruskal's algorithm over the
+ *   shuffled edges between tiles, with a union-find of tiles, keeps exactly
+ *   the seam edges needed to join the tiles into one tree without a cycle.
+ */
+PackedMaze createTiledMaze(int numRows, int numCols,
+                           int tileSize, uint64_t seed) {
+    if (tileSize <= 0) error("Maze tiles must have a positive size.");
+    PackedMaze maze(numRows, numCols);
+    if (numRows == 0 || numCols == 0) return maze;
+
+    int numTileRows = (numRows + tileSize - 1) / tileSize;
+    int numTileCols = (numCols + tileSize - 1) / tileSize;
+    int numTiles = numTileRows * numTileCols;
+
+    // STEP 1: Build a maze in every tile, in parallel
+    TiledMazeState state;
+    state.numRows = numRows;
+    state.numCols = numCols;
+    state.tileSize = tileSize;
+    state.numTileCols = numTileCols;
+    state.seed = seed;
+    state.tileEdges.resize(numTiles);
+    parallelFor(numTiles, buildTiles, &state);
+
+    for (int tileNum = 0; tileNum < numTiles; tileNum++) {
+        vector<int>& edges = state.tileEdges[tileNum];
+        for (int i = 0; i < int(edges.size()); i++) {
+            openPassage(maze, edges[i]);
+        }
+        vector<int>().swap(edges);
+    }
+
+    // STEP 2: Gather the edges that cross from one tile into another, and
+    //         shuffle them with a stream no tile uses
+    vector<int> seams;
+    for (int row = 0; row < numRows; row++) {
+        for (int col = tileSize - 1; col < numCols - 1; col += tileSize) {
+            seams.push_back(2 * (row * numCols + col));
+        }
+    }
+    for (int row = tileSize - 1; row < numRows - 1; row += tileSize) {
+        for (int col = 0; col < numCols; col++) {
+            seams.push_back(2 * (row * numCols + col) + 1);
+        }
+    }
+    FastRandom random(seed, numTiles);
+    for (int i = int(seams.size()) - 1; i > 0; i--) {
+        swap(seams[i], seams[random.nextInt(i + 1)]);
+    }
+
+    // STEP 3: Stitch the tiles together with Kruskal's algorithm over tiles
+    UnionFind tiles(numTiles, numTileCols);
+    for (int tileNum = 0; tileNum < numTiles; tileNum++) {
+        tiles.makeSet(tileNum);
+    }
+    int numJoined = 0;
+    for (int i = 0; i < int(seams.size()) && numJoined < numTiles - 1; i++) {
+        int nodeNum = seams[i] / 2;
+        bool isDown = seams[i] % 2 == 1;
+        int row = nodeNum / numCols;
+        int col = nodeNum % numCols;
+        int tileNum = (row / tileSize) * numTileCols + col / tileSize;
+        int neighborTile = isDown ? tileNum + numTileCols : tileNum + 1;
+        if (tiles.unite(tileNum, neighborTile)) {
+            openPassage(maze, seams[i]);
+            numJoined++;
+        }
+    }
+    return maze;
+}
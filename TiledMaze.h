@@ -0,0 +1,43 @@
+/******************************************************************************
+ * File: TiledMaze.h
+ *
+ * Eric Beach
+ *
+ * Parallel maze generation: the grid is cut into square tiles, each tile gets
+ *   a maze of its own via Kruskal's algorithm on a worker thread, and then a
+ *   final Kruskal pass over the edges between tiles stitches them together.
+ *   The tiles are independent of one another, so generation time drops with
+ *   the number of cores.
+ */
+
+#ifndef __Trailblazer__TiledMaze__
+#define __Trailblazer__TiledMaze__
+
+#include "PackedMaze.h"
+#include <stdint.h>
+
+/* Constant: kDefaultMazeTileSize
+ *
+ * The width and height of the tiles createTiledMaze uses by default.  Big
+ *   enough that a tile's maze is not visibly boxed in, small enough that
+ *   even a medium maze has a tile for every core, and a tile's union-find
+ *   fits in cache.
+ */
+const int kDefaultMazeTileSize = 128;
+
+/* Function: createTiledMaze
+ *
+ * Creates a numRows x numCols maze out of tileSize x tileSize tiles (the
+ *   tiles along the bottom and right edges may be smaller).  The result is
+ *   still a perfect maze (exactly one path between any two cells), but any
+ *   two neighboring tiles are joined by at most one passage.
+ * Each tile draws its random numbers from its own FastRandom stream of the
+ *   given seed, so the same seed and tile size always give the same maze,
+ *   however many threads build it.  The version without a seed takes one
+ *   from the Stanford library's generator and uses the default tile size.
+ */
+PackedMaze createTiledMaze(int numRows, int numCols);
+PackedMaze createTiledMaze(int numRows, int numCols,
+                           int tileSize, uint64_t seed);
+
+#endif /* defined(__Trailblazer__TiledMaze__) */
@@ -13,6 +13,9 @@
 #include "TrailblazerTypes.h"
 #include "set.h"
 #include "grid.h"
+#include "PackedMaze.h"
+#include "FastRandom.h"
+#include "EdgeCostTable.h"
 
 /* Function: shortestPath
  * 
@@ -35,6 +38,33 @@ shortestPath(Loc start,
              double costFn(Loc from, Loc to, Grid<double>& world),
              double heuristic(Loc start, Loc end, Grid<double>& world));
 
+/* Function: shortestPath
+ *
+ * Like shortestPath above, but looks up the cost of each move in a table
+ * built for the world, rather than calling the cost function, which is
+ * faster when several searches are run on a world that doesn't change.
+ */
+Vector<Loc>
+shortestPath(Loc start,
+             Loc end,
+             Grid<double>& world,
+             EdgeCostTable& edgeCosts,
+             double heuristic(Loc start, Loc end, Grid<double>& world));
+
+/* Type: MazeAlgorithm
+ *
+ * The algorithms createMaze and createPackedMaze can build a maze with.  Both
+ * Kruskal's and Prim's produce a minimum spanning tree of random edge weights;
+ * Kruskal's mazes have many short dead ends, while Prim's grow out from the
+ * center.  Eller's builds the maze a row at a time (see EllerMaze.h), which
+ * gives long horizontal corridors.  A tiled maze is built by Kruskal's
+ * algorithm in square tiles on all cores at once (see TiledMaze.h).  Only
+ * Wilson's algorithm picks every possible maze with the same probability.
+ */
+enum MazeAlgorithm {
+  KRUSKAL_MAZE, PRIM_MAZE, ELLER_MAZE, TILED_MAZE, WILSON_MAZE
+};
+
 /* Function: createMaze
  * 
  * Creates a maze of the specified dimensions using a randomized version of
@@ -47,4 +77,29 @@ shortestPath(Loc start,
  */
 Set<Edge> createMaze(int numRows, int numCols);
 
+/* Function: createMaze
+ *
+ * Like createMaze above, but builds the maze with the given algorithm.
+ */
+Set<Edge> createMaze(int numRows, int numCols, MazeAlgorithm algorithm);
+
+/* Function: createPackedMaze
+ *
+ * Creates a maze of the specified dimensions using a randomized version of
+ * Kruskal's algorithm, like createMaze, but returns it as a PackedMaze
+ * (two bits per cell) rather than a Set<Edge>.  This is the version to use
+ * for large mazes.
+ */
+PackedMaze createPackedMaze(int numRows, int numCols);
+PackedMaze createPackedMaze(int numRows, int numCols, MazeAlgorithm algorithm);
+
+/* Function: createPackedMaze
+ *
+ * Like createPackedMaze above, but draws every random number from the given
+ * generator, so that a generator seeded with the same value gives the same
+ * maze every time.
+ */
+PackedMaze createPackedMaze(int numRows, int numCols, MazeAlgorithm algorithm,
+                            FastRandom& random);
+
 #endif
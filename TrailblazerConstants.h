@@ -13,4 +13,9 @@ const double kMazeWall = 0.0;
 /* Constant representing the value of a floor cell in a maze. */
 const double kMazeFloor = 1.0;
 
+/* Constant representing the cost of climbing or descending one unit of height
+ * in a terrain, on top of the distance travelled.
+ */
+const double kAltitudePenalty = 100;
+
 #endif
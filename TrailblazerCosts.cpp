@@ -6,12 +6,11 @@
  */
 #include "TrailblazerCosts.h"
 #include "TrailblazerConstants.h"
+#include <algorithm>
 #include <cmath>
 #include <limits>
 using namespace std;
 
-const double kAltitudePenalty = 100;
-
 /* The cost of moving from one location to another in the world is computed as
  *
  *		distance(loc1, loc2) * k * |Delta h|
@@ -38,7 +37,26 @@ double terrainCost(Loc from, Loc to, Grid<double>& world) {
 
 	/* Determine the absolute distance between the points. */
 	double distance = sqrt(double(drow * drow + dcol * dcol));
-	double dheight = fabs(world[to.row][to.col] - world[from.row][from.col]);
+	double dheight = fabs(world.unchecked(to.row, to.col) -
+	                      world.unchecked(from.row, from.col));
+	return distance + kAltitudePenalty * dheight;
+}
+
+/* The same cost over a Heightfield.  Heights are widened back to doubles
+ * before they are subtracted, so the cost is exact for the stored heights.
+ */
+double terrainCost(Loc from, Loc to, const Heightfield& heights) {
+	if (from == to) return 0.0;
+
+	int drow = abs(to.row - from.row);
+	int dcol = abs(to.col - from.col);
+	if (drow > 1 || dcol > 1) {
+		error("Non-adjacent locations passed into cost function.");
+	}
+
+	double distance = sqrt(double(drow * drow + dcol * dcol));
+	double dheight = fabs(heights.get(to.row, to.col) -
+	                      heights.get(from.row, from.col));
 	return distance + kAltitudePenalty * dheight;
 }
 
@@ -52,7 +70,19 @@ double terrainCost(Loc from, Loc to, Grid<double>& world) {
 double terrainHeuristic(Loc from, Loc to, Grid<double>& world) {
 	int drow = to.row - from.row;
 	int dcol = to.col - from.col;
-	double dheight = fabs(world[to.row][to.col] - world[from.row][from.col]);
+	double dheight = fabs(world.unchecked(to.row, to.col) -
+	                      world.unchecked(from.row, from.col));
+	return sqrt((double) (drow * drow + dcol * dcol)) + kAltitudePenalty * dheight;
+}
+
+/* The same heuristic over a Heightfield.  It reads the same stored heights as
+ * the Heightfield terrainCost, so it is admissible for that cost.
+ */
+double terrainHeuristic(Loc from, Loc to, const Heightfield& heights) {
+	int drow = to.row - from.row;
+	int dcol = to.col - from.col;
+	double dheight = fabs(heights.get(to.row, to.col) -
+	                      heights.get(from.row, from.col));
 	return sqrt((double) (drow * drow + dcol * dcol)) + kAltitudePenalty * dheight;
 }
 
@@ -76,7 +106,8 @@ double mazeCost(Loc from, Loc to, Grid<double>& world) {
 		return numeric_limits<double>::infinity();
 
 	/* See if we're moving to or from a wall. */
-	if (world[from.row][from.col] == kMazeWall || world[to.row][to.col] == kMazeWall)
+	if (world.unchecked(from.row, from.col) == kMazeWall ||
+	    world.unchecked(to.row, to.col) == kMazeWall)
 		return numeric_limits<double>::infinity();
 
 	return 1.0;
@@ -98,3 +129,65 @@ double mazeHeuristic(Loc from, Loc to, Grid<double>& world) {
 double zeroHeuristic(Loc, Loc, Grid<double>&) {
 	return 0.0;
 }
+
+/* Returns the height of the terrain at a fractional (row, col) position by
+ * bilinearly interpolating between the four surrounding cells.
+ */
+static double sampleHeight(Grid<double>& world, double row, double col) {
+	int row0 = int(floor(row));
+	int col0 = int(floor(col));
+	int row1 = min(row0 + 1, world.numRows() - 1);
+	int col1 = min(col0 + 1, world.numCols() - 1);
+	double rowFrac = row - row0;
+	double colFrac = col - col0;
+
+	double top = world[row0][col0] * (1 - colFrac) + world[row0][col1] * colFrac;
+	double bottom = world[row1][col0] * (1 - colFrac) + world[row1][col1] * colFrac;
+	return top * (1 - rowFrac) + bottom * rowFrac;
+}
+
+/* The straight-line cost is computed just as in terrainCost, except that the
+ * height differential is accumulated over evenly spaced samples along the
+ * line.  We take one sample per row or column crossed (whichever is more),
+ * which means each sample along a row, column, or diagonal lands exactly on a
+ * cell and the result matches a cell-by-cell walk along the same line.
+ */
+double terrainSegmentCost(Loc from, Loc to, Grid<double>& world) {
+	if (from == to) return 0.0;
+
+	int drow = to.row - from.row;
+	int dcol = to.col - from.col;
+	int numSteps = max(abs(drow), abs(dcol));
+
+	double climb = 0.0;
+	double prevHeight = world[from.row][from.col];
+	for (int step = 1; step <= numSteps; step++) {
+		double t = double(step) / numSteps;
+		double height = sampleHeight(world, from.row + t * drow,
+		                             from.col + t * dcol);
+		climb += fabs(height - prevHeight);
+		prevHeight = height;
+	}
+
+	double distance = sqrt(double(drow * drow + dcol * dcol));
+	return distance + kAltitudePenalty * climb;
+}
+
+/* In a maze, motion is only ever possible along rows and columns, so a
+ * straight segment is passable exactly when it is axis-aligned and every cell
+ * it covers is a floor.
+ */
+double mazeSegmentCost(Loc from, Loc to, Grid<double>& world) {
+	if (from == to) return 0.0;
+	if (from.row != to.row && from.col != to.col)
+		return numeric_limits<double>::infinity();
+
+	int drow = (to.row > from.row) - (to.row < from.row);
+	int dcol = (to.col > from.col) - (to.col < from.col);
+	for (Loc curr = from; ; curr.row += drow, curr.col += dcol) {
+		if (world[curr.row][curr.col] == kMazeWall)
+			return numeric_limits<double>::infinity();
+		if (curr == to) break;
+	}
+	return abs(to.row - from.row) + abs(to.col - from.col);
+}
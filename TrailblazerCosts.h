@@ -13,13 +13,18 @@
 
 #include "TrailblazerTypes.h"
 #include "grid.h"
+#include "Heightfield.h"
 
 /* Function: terrainCost
  *
  * A function that given two adjacent locations in a terrain, returns the cost
- * associated with moving from the first location to the second.
+ * associated with moving from the first location to the second.  The
+ * Heightfield version works out the same cost from the stored heights (see
+ * HeightPrecision in Heightfield.h for how far those may be from the
+ * originals).
  */
 double terrainCost(Loc from, Loc to, Grid<double>& world);
+double terrainCost(Loc from, Loc to, const Heightfield& heights);
 
 /* Function: terrainHeuristic
  *
@@ -27,6 +32,7 @@ double terrainCost(Loc from, Loc to, Grid<double>& world);
  * of moving from the first location all the way to the second.
  */ 
 double terrainHeuristic(Loc from, Loc to, Grid<double>& world);
+double terrainHeuristic(Loc from, Loc to, const Heightfield& heights);
 
 /* Function: mazeCost
  *
@@ -50,4 +56,24 @@ double mazeHeuristic(Loc from, Loc to, Grid<double>& world);
  */
 double zeroHeuristic(Loc from, Loc to, Grid<double>& world);
 
+/* Function: terrainSegmentCost
+ *
+ * A function that, given any two locations in a terrain, returns the cost of
+ * travelling in a straight line from the first to the second.  The height
+ * along the line is sampled from the terrain by bilinear interpolation once
+ * per row or column crossed, so for adjacent locations this agrees exactly
+ * with terrainCost.
+ */
+double terrainSegmentCost(Loc from, Loc to, Grid<double>& world);
+
+/* Function: mazeSegmentCost
+ *
+ * A function that, given any two locations in a maze, returns the cost of
+ * travelling in a straight line from the first to the second.  This is the
+ * length of the line if it runs along a row or column and crosses only
+ * floors, and is infinite otherwise.  For adjacent locations this agrees
+ * exactly with mazeCost.
+ */
+double mazeSegmentCost(Loc from, Loc to, Grid<double>& world);
+
 #endif
@@ -12,6 +12,9 @@
 #include "strlib.h"
 #include "error.h"
 #include "UnionFind.h"
+#include "PathSmoother.h"
+#include "Reachability.h"
+#include "EdgeCostTable.h"
 #include <string>
 #include <iomanip>
 #include <iostream>
@@ -41,10 +44,12 @@ enum WorldSize {
 
 /* Type: AlgorithmType
  *
- * An enumerated type representing one of Dijkstra's algorithm or A* search.
+ * An enumerated type representing one of Dijkstra's algorithm, A* search,
+ * A* search followed by any-angle smoothing of the resulting path, or A*
+ * search that looks move costs up in a precomputed table.
  */
 enum AlgorithmType {
-  DIJKSTRA, A_STAR
+  DIJKSTRA, A_STAR, A_STAR_ANY_ANGLE, A_STAR_TABLE
 };
 
 /* Type: UIState
@@ -86,6 +91,8 @@ const string kClearLabel("Clear");
 const string kQuitLabel("Quit");
 const string kRandomTerrainLabel("Random Terrain		");
 const string kRandomMazeLabel("Random Maze		 ");
+const string kRandomPrimMazeLabel("Random Maze (Prim)	 ");
+const string kRandomWilsonMazeLabel("Random Maze (Wilson)");
 const string kLoadWorldLabel("Load World");
 const string kSmallWorldLabel("Small World		 ");
 const string kMediumWorldLabel("Medium World		");
@@ -93,6 +100,8 @@ const string kLargeWorldLabel("Large World		 ");
 const string kHugeWorldLabel("Huge World       ");
 const string kDijkstraLabel("Dijkstra's Algorithm			");
 const string kAStarLabel("A* Search	 ");
+const string kAnyAngleLabel("A* Search (Any-Angle)	 ");
+const string kTableLabel("A* Search (Cost Table)	 ");
 const string kSelectedLocationColor("RED");
 const string kPathColor("RED");
 const string kBackgroundColor("Black");
@@ -147,28 +156,7 @@ static WorldSize getWorldSize(string sizeLabel);
 static double runShortestPath(Grid<double>& world, 
                               WorldType worldType,
                               Loc start, Loc end);
-static
-Vector<Loc> invoke(Vector<Loc> pathFn(Loc start,
-                                      Loc end,
-                                      Grid<double>& world,
-                                      double costFn(Loc, Loc, Grid<double>&)),
-                   Loc start,
-                   Loc end,
-                   Grid<double>& world,
-                   double costFn(Loc from, Loc to, Grid<double>& world),
-                   double heuristicFn(Loc from, Loc to, Grid<double>& world));
-
-static
-Vector<Loc> invoke(Vector<Loc> pathFn(Loc start,
-                                      Loc end,
-                                      Grid<double>& world,
-                                      double costFn(Loc, Loc, Grid<double>&),
-                                      double heuristicFn(Loc, Loc, Grid<double>&)),
-                   Loc start,
-                   Loc end,
-                   Grid<double>& world,
-                   double costFn(Loc from, Loc to, Grid<double>& world),
-                   double heuristicFn(Loc from, Loc to, Grid<double>& world));
+static void indexWorld(Grid<double>& world, WorldType worldType);
 
 /* Internal global variables */
 
@@ -193,8 +181,22 @@ static Vector<GLine*> gHighlightedPath;
 /* Which cells have been colored by the user. */
 static Grid<bool> gMarked;
 
-/* When they're colored, the values we've marked them with. */
-static Grid<double> gMarkedValues;
+/* The world on display, whose values colored cells are restored from.  This
+ * points at the caller's world rather than copying it.
+ */
+static Grid<double>* gMarkedValues = NULL;
+
+/* Which cells of the current world can reach one another.  This is rebuilt
+ * whenever the world changes, so that searches between disconnected regions
+ * can be turned away without searching.
+ */
+static ReachabilityIndex gReachability;
+
+/* The cost of every move in the current world.  It takes 64 bytes per cell,
+ * so it is only built the first time a cost-table search is run on a world,
+ * and released whenever the world changes.
+ */
+static EdgeCostTable gEdgeCosts;
 
 /*** Function implementations ***/
 
@@ -223,7 +225,7 @@ static void drawWorld(Grid<double>& world) {
 
   /* With the redraw, no locations are marked anymore. */
 	gMarked.resize(world.numRows(), world.numCols());
-	gMarkedValues = world;
+	gMarkedValues = &world;
 
   /* Draw each cell. */
 	for (int row = 0; row < world.numRows(); row++) {
@@ -248,7 +250,7 @@ static void uncolorSquares() {
     for (int col = 0; col < gMarked.numCols(); col++) {
       if (gMarked[row][col]) {
         Loc loc = { row, col };
-        colorLocation(loc, gMarkedValues[row][col], GRAY);
+        colorLocation(loc, (*gMarkedValues)[row][col], GRAY);
 
         /* Unmark this cell; it's no longer colored. */
         gMarked[row][col] = false;
@@ -367,6 +369,8 @@ static void initializeWindow() {
   gTypeList = new GChooser();
   gTypeList->addItem(kRandomTerrainLabel);
   gTypeList->addItem(kRandomMazeLabel);
+  gTypeList->addItem(kRandomPrimMazeLabel);
+  gTypeList->addItem(kRandomWilsonMazeLabel);
   gTypeList->setSelectedItem(kRandomTerrainLabel);
   gWindow->addToRegion(gTypeList, "SOUTH");
   
@@ -383,6 +387,8 @@ static void initializeWindow() {
   gAlgorithmList = new GChooser();
   gAlgorithmList->addItem(kDijkstraLabel);
   gAlgorithmList->addItem(kAStarLabel);
+  gAlgorithmList->addItem(kAnyAngleLabel);
+  gAlgorithmList->addItem(kTableLabel);
   gWindow->addToRegion(gAlgorithmList, "NORTH");
 
   /* Add the buttons. */
@@ -413,9 +419,11 @@ static bool regenerateWorld(Grid<double>& world, WorldType& worldType) {
   if (typeLabel == kRandomTerrainLabel) {
     int numRows = kTerrainNumRows[worldSize];
     int numCols = kTerrainNumCols[worldSize];
-    newWorld = generateRandomTerrain(numRows, numCols);
+    generateRandomTerrain(numRows, numCols).swap(newWorld);
     newType = TERRAIN_WORLD;
-  } else if (typeLabel == kRandomMazeLabel) {
+  } else if (typeLabel == kRandomMazeLabel ||
+             typeLabel == kRandomPrimMazeLabel ||
+             typeLabel == kRandomWilsonMazeLabel) {
     int numRows = kMazeNumRows[worldSize];
     int numCols = kMazeNumCols[worldSize];
 
@@ -426,7 +434,11 @@ static bool regenerateWorld(Grid<double>& world, WorldType& worldType) {
        * m x n maze has size (2m - 1) x (2n - 1), so we rescale the size of the
        * maze based on the number of logical rows and columns we want.
        */
-      newWorld = generateRandomMaze(numRows / 2 + 1, numCols / 2 + 1);
+      MazeAlgorithm algorithm = KRUSKAL_MAZE;
+      if (typeLabel == kRandomPrimMazeLabel) algorithm = PRIM_MAZE;
+      if (typeLabel == kRandomWilsonMazeLabel) algorithm = WILSON_MAZE;
+      generateRandomMaze(numRows / 2 + 1, numCols / 2 + 1,
+                         algorithm).swap(newWorld);
       newType = MAZE_WORLD;
     } catch (const ErrorException& e) {
       cout << e.getMessage() << endl;
@@ -436,8 +448,10 @@ static bool regenerateWorld(Grid<double>& world, WorldType& worldType) {
     error("Invalid world type provided.");
   }
 
-  world = newWorld;
+  /* Hand the new world over without copying it. */
+  world.swap(newWorld);
   worldType = newType;
+  indexWorld(world, worldType);
   return true;
 }
 
@@ -469,6 +483,10 @@ static AlgorithmType getAlgorithmType() {
     return DIJKSTRA;
   } else if (algorithmLabel == kAStarLabel) {
     return A_STAR;
+  } else if (algorithmLabel == kAnyAngleLabel) {
+    return A_STAR_ANY_ANGLE;
+  } else if (algorithmLabel == kTableLabel) {
+    return A_STAR_TABLE;
   } else {
     error("Invalid algorithm provided.");
   }
@@ -630,11 +648,24 @@ static bool tryLoadWorld(Grid<double>& world, WorldType& worldType) {
     return false;
   }
 
-  world = newWorld;
+  world.swap(newWorld);
   worldType = newWorldType;
+  indexWorld(world, worldType);
   return true;
 }
 
+/* Labels the connected regions of a freshly generated or loaded world, and
+ * drops the move costs of the old one.
+ */
+static void indexWorld(Grid<double>& world, WorldType worldType) {
+  if (worldType == TERRAIN_WORLD) {
+    gReachability.build(world, terrainCost);
+  } else if (worldType == MAZE_WORLD) {
+    gReachability.build(world, mazeCost);
+  } else error("Unknown world type.");
+  gEdgeCosts.clear();
+}
+
 /* Given a State object representing the state of the world, initializes it to
  * hold a default set of values.
  */
@@ -646,6 +677,13 @@ static void initializeState(State& state) {
 }
 
 static void runSearch(State& state) {
+  /* No search can succeed if the two locations aren't connected. */
+  if (!gReachability.isReachable(gStartLocation, gEndLocation)) {
+    cout << "No path: the end location cannot be reached from the start."
+         << endl;
+    return;
+  }
+
 	try {
 		double pathCost = runShortestPath(state.world, 
 	                                    state.worldType,
@@ -757,21 +795,39 @@ static double runShortestPath(Grid<double>& world,
   /* Determine which cost/heuristic functions to use. */
   double (*costFn)(Loc, Loc, Grid<double>&);
   double (*hFn)(Loc, Loc, Grid<double>&);
+  double (*segmentFn)(Loc, Loc, Grid<double>&);
 
   if (worldType == TERRAIN_WORLD) {
     costFn = terrainCost;
     hFn = terrainHeuristic;
+    segmentFn = terrainSegmentCost;
   } else if (worldType == MAZE_WORLD) {
     costFn = mazeCost;
     hFn = mazeHeuristic;
+    segmentFn = mazeSegmentCost;
   } else error("Unknown world type.");
 
   /* Invoke the student's shortestPath function to find out the cost of the path.
-   * This uses the indirect calling function invoke, which is described later
-   * on.  Note that if we're using A* search, we disable the heuristic.
+   * Note that if we're using Dijkstra's algorithm, we disable the heuristic.
+   * A cost-table search tabulates every move of the world the first time it
+   * runs on it, and later ones look the costs up in that table.
    */
-	path = invoke(shortestPath, start, end, world, costFn,
-                algType == A_STAR ? hFn : zeroHeuristic);
+  if (algType == A_STAR_TABLE) {
+    if (!gEdgeCosts.isBuilt()) gEdgeCosts.build(world, costFn);
+    path = shortestPath(start, end, world, gEdgeCosts, hFn);
+  } else {
+    path = shortestPath(start, end, world, costFn,
+                        algType == DIJKSTRA ? zeroHeuristic : hFn);
+  }
+
+  /* For an any-angle search, pull the path taut into straight segments.  The
+   * waypoints are no longer adjacent, so from here on segments are costed by
+   * the straight-line cost function.
+   */
+  if (algType == A_STAR_ANY_ANGLE) {
+    path = smoothPath(path, world, segmentFn);
+    costFn = segmentFn;
+  }
 
 	if (path.isEmpty()) {
 		cout << "Warning: Returned path is empty." << endl;
@@ -785,51 +841,14 @@ static double runShortestPath(Grid<double>& world,
   return costOf(path, world, costFn);
 }
 
-/* This code requires explanation.
- *
- * Our goal is to make it so that if the student uses the default signature for
- * the shortestPath function, we will call it and pass in the zero heuristic.
- * Otherwise, we will call it and pass in the specified heuristic.
- *
- * To do this, we overload a function called invoke that takes in a function
- * to call (this should be the student's shortestPath function), then all the
- * arguments we would ever want to pass in.  One version of the overload uses
- * the normal, four-argument version of shortestPath and ignores its final
- * argument.  The other version will match the five-argument version of
- * shortestPath and does indeed use the final argument.
- *
- * This extra level of indirection makes it possible for us to not have to
- * change the driver code and just have everything "work."  We do need to
- * rebuild the driver code object file when the header changes, though.
- */
-static 
-Vector<Loc> invoke(Vector<Loc> pathFn(Loc start,
-                                      Loc end,
-                                      Grid<double>& world,
-                                      double costFn(Loc, Loc, Grid<double>&)),
-                   Loc start,
-                   Loc end,
-                   Grid<double>& world,
-                   double costFn(Loc from, Loc to, Grid<double>& world),
-                   double heuristicFn(Loc from, Loc to, Grid<double>& world)) {
-  return pathFn(start, end, world, costFn);
-}
-
-static 
-Vector<Loc> invoke(Vector<Loc> pathFn(Loc start,
-                                      Loc end,
-                                      Grid<double>& world,
-                                      double costFn(Loc, Loc, Grid<double>&),
-                                      double heuristicFn(Loc, Loc, Grid<double>&)),
-                   Loc start,
-                   Loc end,
-                   Grid<double>& world,
-                   double costFn(Loc from, Loc to, Grid<double>& world),
-                   double heuristicFn(Loc from, Loc to, Grid<double>& world)) {
-  return pathFn(start, end, world, costFn, heuristicFn);
-}
-
 #include "UnionFindTest.h"
+#include "EdgeCostTableTest.h"
+#ifdef RUN_BOUNDED_SEARCH_TESTS
+#include "BoundedSearchTest.h"
+#endif
+#ifdef RUN_GRID_LAYOUT_BENCHMARKS
+#include "GridLayoutBenchmark.h"
+#endif
 
 /* Main program. */
 int main() {
@@ -839,6 +858,13 @@ int main() {
   drawWorld(state.world);
     
     runUnionFindUnitTests();
+    runEdgeCostTableUnitTests();
+#ifdef RUN_BOUNDED_SEARCH_TESTS
+    runBoundedSearchUnitTests();
+#endif
+#ifdef RUN_GRID_LAYOUT_BENCHMARKS
+    runGridLayoutBenchmarks();
+#endif
     
   /* Process events as they happen. */
   while (true) {
@@ -17,13 +17,22 @@ const int kLargePrime = 78979871;
  * A value that can be bitwise-ANDed with an integer to force it to be nonnegative,
  * which is useful when writing hash functions.
  */
-const int kHashMask = 0x7FFFFFF;
+const int kHashMask = 0x7FFFFFFF;
 
 /* Utility constructor functions. */
 Loc makeLoc(int row, int col) {
 	Loc result = { row, col };
 	return result;
 }
+CellId makeCellId(Loc loc, int numCols) {
+	CellId result = { uint32_t(loc.row) * uint32_t(numCols) +
+	                  uint32_t(loc.col) };
+	return result;
+}
+Loc cellIdToLoc(CellId id, int numCols) {
+	return makeLoc(int(id.index / uint32_t(numCols)),
+	               int(id.index % uint32_t(numCols)));
+}
 Edge makeEdge(Loc start, Loc end) {
 	Edge result = { start, end };
 	return result;
@@ -59,6 +68,25 @@ int hashCode(Loc l) {
 	return (l.row + kLargePrime * l.col) & kHashMask;
 }
 
+bool operator < (CellId lhs, CellId rhs) {
+	return lhs.index < rhs.index;
+}
+
+bool operator == (CellId lhs, CellId rhs) {
+	return lhs.index == rhs.index;
+}
+
+bool operator != (CellId lhs, CellId rhs) {
+	return lhs.index != rhs.index;
+}
+
+/* Spread the bits of the index around (it is often a small number), keeping
+ * the result nonnegative.
+ */
+int hashCode(CellId id) {
+	return int((id.index * 2654435761U) & kHashMask);
+}
+
 bool operator < (Edge lhs, Edge rhs) {
 	if (lhs.start != rhs.start) return lhs.start < rhs.start;
 	return lhs.end < rhs.end;	
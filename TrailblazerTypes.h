@@ -7,6 +7,8 @@
 #ifndef TrailblazerTypes_Included
 #define TrailblazerTypes_Included
 
+#include <stdint.h>
+
 /* Type: Loc
  *
  * A type representing a location in the world, represented as a pair of a row
@@ -20,6 +22,24 @@ struct Loc {
 /* Utility function to construct a Loc from its location. */
 Loc makeLoc(int row, int col);
 
+/* Type: CellId
+ *
+ * A location packed into a single 32-bit number, row * numCols + col, for a
+ * world with numCols columns.  A CellId is half the size of a Loc and is
+ * compared and hashed as one integer, so it is the better key for the
+ * queues, parent tables and sets inside the search and maze code.  Only
+ * locations in the same world can be compared meaningfully.
+ */
+struct CellId {
+	uint32_t index;
+};
+
+/* Utility functions to convert between a Loc and a CellId in a world with the
+ * given number of columns.
+ */
+CellId makeCellId(Loc loc, int numCols);
+Loc cellIdToLoc(CellId id, int numCols);
+
 /* Type: Color
  *
  * An enumerated type representing a color for a node during an execution of
@@ -63,6 +83,10 @@ bool operator != (Loc lhs, Loc rhs);
 bool operator <= (Loc lhs, Loc rhs);
 bool operator >= (Loc lhs, Loc rhs);
 
+bool operator <	 (CellId lhs, CellId rhs);
+bool operator == (CellId lhs, CellId rhs);
+bool operator != (CellId lhs, CellId rhs);
+
 bool operator <	 (Edge lhs, Edge rhs);
 bool operator >	 (Edge lhs, Edge rhs);
 bool operator == (Edge lhs, Edge rhs);
@@ -76,6 +100,7 @@ bool operator >= (Edge lhs, Edge rhs);
  * solution, but you're welcome to do so if you find them useful.
  */
 int hashCode(Loc l);
+int hashCode(CellId id);
 int hashCode(Edge e);
 
 #endif
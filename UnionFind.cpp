@@ -10,6 +10,7 @@
  */
 
 #include "UnionFind.h"
+#include <limits>
 
 using namespace std;
 
@@ -19,9 +20,15 @@ using namespace std;
  * 
  */
 UnionFind::UnionFind(const int maxSetNum, const int numCols) {
+    // every node number and set size must fit in a UnionFindIndex
+    if (maxSetNum < 0 ||
+        (unsigned int) maxSetNum > numeric_limits<UnionFindIndex>::max()) {
+        error("Too many nodes for the UnionFind index type");
+    }
     MAX_SET_NUM = maxSetNum;
     NUM_COLS = numCols;
-    nodeParents = new int[MAX_SET_NUM];
+    nodeParents = new UnionFindIndex[MAX_SET_NUM];
+    setSizes = new UnionFindIndex[MAX_SET_NUM];
 }
 
 /*
@@ -29,6 +36,7 @@ UnionFind::UnionFind(const int maxSetNum, const int numCols) {
  */
 UnionFind::~UnionFind() {
     delete[] nodeParents;
+    delete[] setSizes;
 }
 
 /*
@@ -37,19 +45,14 @@ UnionFind::~UnionFind() {
  *   if two nodes have the same root, they are in the same set)
  */
 Loc UnionFind::find(const Loc& toFind) {
-    int nodeNum = locToNodeNum(toFind);
-    if (nodeNum >= MAX_SET_NUM) error("Array out of bounds");
-    int root = find(nodeNum);
-    return nodeNumToLoc(root);
+    return nodeNumToLoc(findIndex(locToNodeNum(toFind)));
 }
 
 /*
- * Join node b to node a such that node a will now become the parent of node b.
+ * Join the sets containing locations a and b (see unite).
  */
-void UnionFind::join(const Loc& a, const Loc& b) {
-    int aRootNodeNum = find(locToNodeNum(a));
-    int bRootNodeNum = find(locToNodeNum(b));
-    nodeParents[bRootNodeNum] = aRootNodeNum;
+bool UnionFind::join(const Loc& a, const Loc& b) {
+    return unite(locToNodeNum(a), locToNodeNum(b));
 }
 
 /*
@@ -57,38 +60,101 @@ void UnionFind::join(const Loc& a, const Loc& b) {
  *   Location (i.e., as its own single element set).
  */
 void UnionFind::makeSet(const Loc& input) {
-    int nodeNum = locToNodeNum(input);
-    if (nodeNum >= MAX_SET_NUM) error("Array out of bounds");
+    makeSet(locToNodeNum(input));
+}
+
+/*
+ * Add a node number into the data structure as a singleton set.
+ */
+void UnionFind::makeSet(const int nodeNum) {
+    checkNodeNum(nodeNum);
     nodeParents[nodeNum] = nodeNum;
+    setSizes[nodeNum] = 1;
+}
+
+/*
+ * Find the root node number for a particular node number.
+ */
+int UnionFind::findIndex(const int nodeNum) {
+    checkNodeNum(nodeNum);
+    return findRoot(nodeNum);
+}
+
+/*
+ * Join the sets containing nodes a and b.  The root of the smaller set
+ *   becomes a child of the root of the larger set (union by size), so a
+ *   node's depth only grows when the size of its set at least doubles.
+ * Returns false without changing anything if a and b are already in the
+ *   same set, which lets callers check and join with a single call.
+ */
+bool UnionFind::unite(const int a, const int b) {
+    checkNodeNum(a);
+    checkNodeNum(b);
+    int aRootNodeNum = findRoot(a);
+    int bRootNodeNum = findRoot(b);
+    if (aRootNodeNum == bRootNodeNum) return false;
+    
+    if (setSizes[aRootNodeNum] < setSizes[bRootNodeNum]) {
+        int temp = aRootNodeNum;
+        aRootNodeNum = bRootNodeNum;
+        bRootNodeNum = temp;
+    }
+    nodeParents[bRootNodeNum] = aRootNodeNum;
+    setSizes[aRootNodeNum] += setSizes[bRootNodeNum];
+    return true;
+}
+
+/*
+ * Two nodes are in the same set exactly when they have the same root.
+ */
+bool UnionFind::connected(const int a, const int b) {
+    checkNodeNum(a);
+    checkNodeNum(b);
+    return findRoot(a) == findRoot(b);
+}
+
+/*
+ * A CellId is row * numCols + col, so its index is the node number.
+ */
+void UnionFind::makeSet(const CellId id) {
+    makeSet(int(id.index));
+}
+
+CellId UnionFind::find(const CellId id) {
+    CellId root = { uint32_t(findIndex(int(id.index))) };
+    return root;
+}
+
+bool UnionFind::join(const CellId a, const CellId b) {
+    return unite(int(a.index), int(b.index));
 }
 
 ////////// PRIVATE METHODS //////////
+/*
+ * Node numbers index straight into the arrays, so make sure they are in
+ *   range before using them.
+ */
+void UnionFind::checkNodeNum(const int nodeNum) {
+    if (nodeNum < 0 || nodeNum >= MAX_SET_NUM) error("Array out of bounds");
+}
+
 /*
  * Find the root node number of a particular node.
  * This is used to determine whether two nodes are in the same set (i.e.,
  *   if two nodes have the same root, they are in the same set)
  * $nodeNum is the key value in $nodeParents for a given particular node.
  */
-int UnionFind::find(const int nodeNum) {
-    // if the node toFind is the parent of itself, we have found the
-    //   root location (i.e., we have found the parent node number)
-    if (nodeParents[nodeNum] == nodeNum) {
-        return nodeNum;
-    }
-    // the node toFind has a parent Location that is not itself, so
-    //   traverse back to find the Location representative of the set
-    //   that toFind is a part of
-    else {
-        // find the immediate parent of nodeNum and then recursively
-        //   find its parent
-        int parent = find(nodeParents[nodeNum]);
-        
-        // store the result of the resursive call, which will contain
-        //   the root for nodeNum that represents the set that
-        //   nodeNum is a part of
-        nodeParents[nodeNum] = parent;
-        return parent;
+int UnionFind::findRoot(const int nodeNum) {
+    // walk up towards the root, pointing each node visited at its
+    //   grandparent along the way (i.e., path halving); this roughly halves
+    //   the length of the path for every later find without needing a
+    //   recursive call per level
+    UnionFindIndex curr = nodeNum;
+    while (nodeParents[curr] != curr) {
+        nodeParents[curr] = nodeParents[nodeParents[curr]];
+        curr = nodeParents[curr];
     }
+    return curr;
 }
 
 /*
@@ -16,16 +16,33 @@
 #include "TrailblazerTypes.h"
 #include "TrailblazerGraphics.h"
 
+/*
+ * Type used to store node numbers (and set sizes) inside UnionFind.
+ * Define UNION_FIND_SMALL_INDEX when building to store them in 16 bits
+ *   instead of 32, which halves the memory UnionFind uses; a UnionFind can
+ *   then hold at most 65535 nodes (e.g., a maze of up to 255 x 255 cells),
+ *   and constructing a larger one reports an error.
+ */
+#ifdef UNION_FIND_SMALL_INDEX
+typedef unsigned short UnionFindIndex;
+#else
+typedef unsigned int UnionFindIndex;
+#endif
+
 /*
  * Create a Disjoint-set data structure (i.e., Union/Find data structure).
  * This class is important for both Prim's algorithm as well as Kruskal's
  *   algorithm. Its main two functions are:
  *   (1) find - determine which set the the specific location is in.
- *   (2) join - join two sets together by making Set B a child of Set A.
+ *   (2) join - join two sets together by making the root of the smaller
+ *       set a child of the root of the larger set.
  * The key to this class is as follows: nodes with the same
  *   parent belong to the same set
  * In other words: if two locations are passed into find and they
  *   both return the same root, then they are in the same set
+ * Joining by size keeps every tree O(log n) deep, and find shortens the
+ *   paths it walks (path halving), so neither operation ever needs to
+ *   recurse or walk a long chain.
  */
 class UnionFind {
  public:
@@ -44,15 +61,41 @@ class UnionFind {
     //   cluster that it is apart of)
     Loc find(const Loc& toFind);
     
-    // Join two subsets into one
-    void join(const Loc& a, const Loc& b);
+    // Join two subsets into one; returns true if a and b were in different
+    //   sets (i.e., a merge happened) and false if they already shared one
+    bool join(const Loc& a, const Loc& b);
     
     // make a set (i.e., add a new element as a singleton set)
     void makeSet(const Loc& input);
+    
+    // The same operations on node numbers (row * numCols + col) rather
+    //   than Loc objects. These skip the conversions between Loc objects
+    //   and node numbers, so they are the ones to use in tight loops.
+    void makeSet(const int nodeNum);
+    
+    // Return the node number of the root of the set containing nodeNum
+    int findIndex(const int nodeNum);
+    
+    // Join the sets containing nodes a and b; returns true if a merge
+    //   happened, as with join
+    bool unite(const int a, const int b);
+    
+    // Return whether nodes a and b are in the same set
+    bool connected(const int a, const int b);
+    
+    // The same operations on CellIds, which are node numbers already (as
+    //   long as the CellIds use the same number of columns as this class)
+    void makeSet(const CellId id);
+    CellId find(const CellId id);
+    bool join(const CellId a, const CellId b);
 
 private:
     // array to store the parent nodes for each node
-    int* nodeParents;
+    UnionFindIndex* nodeParents;
+    
+    // array to store the number of nodes in each set; only meaningful
+    //   for root nodes
+    UnionFindIndex* setSizes;
     
     // the maximum set number that this class should store
     // even if this class will only store two values, node 3 and node 56,
@@ -70,10 +113,13 @@ private:
     //   construct the corresponding Loc object
     Loc nodeNumToLoc(const int nodeNum);
     
+    // report an error if nodeNum is not a valid node number
+    void checkNodeNum(const int nodeNum);
+    
     // find the node number that is the parent (or representative set number)
     //   for a given node number (i.e., determine which set a node number
-    //   belongs to)
-    int find(const int nodeNum);
+    //   belongs to); nodeNum is assumed to be valid
+    int findRoot(const int nodeNum);
 };
 
 #endif /* defined(__Trailblazer__UnionFind__) */
@@ -10,6 +10,44 @@
 #ifndef Trailblazer_UnionFindTest_h
 #define Trailblazer_UnionFindTest_h
 
+#include "ConcurrentUnionFind.h"
+#include "RollbackUnionFind.h"
+#include "Parallel.h"
+
+////////// HELPERS //////////
+// number of nodes used by the concurrent test
+const int kConcurrentTestNodes = 60000;
+
+// the edges the concurrent test joins; node i is joined to node
+//   (i * 7919 + 13) % kConcurrentTestNodes for each of the first two thirds
+//   of the nodes, which gives a mix of big sets, small sets and singletons
+int concurrentTestPartner(int nodeNum) {
+    return (int) (((long long) nodeNum * 7919 + 13) % kConcurrentTestNodes);
+}
+
+// state shared by the threads of the concurrent test
+struct ConcurrentTestState {
+    ConcurrentUnionFind* uFind;
+    int merges;
+};
+
+// join a range of the test edges, counting how many merges happened
+void uniteTestEdges(int begin, int end, void* data) {
+    ConcurrentTestState* state = (ConcurrentTestState*) data;
+    for (int nodeNum = begin; nodeNum < end; nodeNum++) {
+        if (state->uFind->unite(nodeNum, concurrentTestPartner(nodeNum))) {
+            __sync_fetch_and_add(&state->merges, 1);
+        }
+    }
+}
+
+// report an error from whichever chunk holds the last of data's count
+//   nodes, which is run on a thread of its own when there is more than one
+void failLastChunk(int begin, int end, void* data) {
+    (void) begin;
+    if (end == *(int*) data) error("last chunk failed");
+}
+
 ////////// UNIT TESTS //////////
 void runUnionFindUnitTests() {
     UnionFind uFind(6, 2);
@@ -56,6 +94,150 @@ void runUnionFindUnitTests() {
     
     uFind.join(c, d);
     if (uFind.find(a) != uFind.find(d)) error("join function errored");
+    
+    // join reports whether a merge actually happened
+    if (uFind.join(b, d)) error("join function errored");
+    if (!uFind.join(e, f)) error("join function errored");
+    if (uFind.join(f, e)) error("join function errored");
+    
+    // the smaller set is joined under the larger one, whichever order
+    //   the two are given in
+    Loc bigRoot = uFind.find(a);
+    if (!uFind.join(e, a)) error("join function errored");
+    if (uFind.find(e) != bigRoot) error("join function errored");
+    if (uFind.find(f) != bigRoot) error("join function errored");
+    
+    // a long chain of joins must not build a deep tree; with a recursive
+    //   find, this used to be able to overflow the stack
+#ifdef UNION_FIND_SMALL_INDEX
+    const int kChainLength = 65535;
+#else
+    const int kChainLength = 1000000;
+#endif
+    UnionFind chain(kChainLength, kChainLength);
+    for (int col = 0; col < kChainLength; col++) {
+        chain.makeSet(makeLoc(0, col));
+    }
+    for (int col = 1; col < kChainLength; col++) {
+        if (!chain.join(makeLoc(0, col), makeLoc(0, col - 1))) {
+            error("join function errored");
+        }
+    }
+    for (int col = 0; col < kChainLength; col++) {
+        if (chain.find(makeLoc(0, col)) != chain.find(makeLoc(0, 0))) {
+            error("find function errored");
+        }
+    }
+    
+    // the node number versions of the operations
+    UnionFind indexed(6, 2);
+    for (int nodeNum = 0; nodeNum < 6; nodeNum++) {
+        indexed.makeSet(nodeNum);
+    }
+    if (indexed.connected(0, 1)) error("connected function errored");
+    if (!indexed.unite(0, 1)) error("unite function errored");
+    if (!indexed.unite(5, 4)) error("unite function errored");
+    if (!indexed.connected(1, 0)) error("connected function errored");
+    if (indexed.connected(1, 4)) error("connected function errored");
+    if (indexed.unite(1, 0)) error("unite function errored");
+    if (!indexed.unite(1, 5)) error("unite function errored");
+    if (indexed.findIndex(0) != indexed.findIndex(4)) {
+        error("findIndex function errored");
+    }
+    if (indexed.find(makeLoc(2, 1)) != makeLoc(indexed.findIndex(5) / 2,
+                                               indexed.findIndex(5) % 2)) {
+        error("findIndex function errored");
+    }
+    if (indexed.connected(2, 3)) error("connected function errored");
+    
+    // joining the same edges from many threads at once must give the same
+    //   sets, and the same number of merges, as joining them one at a time
+    int numTestEdges = kConcurrentTestNodes * 2 / 3;
+    UnionFind serial(kConcurrentTestNodes, kConcurrentTestNodes);
+    int serialMerges = 0;
+    for (int nodeNum = 0; nodeNum < kConcurrentTestNodes; nodeNum++) {
+        serial.makeSet(nodeNum);
+    }
+    for (int nodeNum = 0; nodeNum < numTestEdges; nodeNum++) {
+        if (serial.unite(nodeNum, concurrentTestPartner(nodeNum))) {
+            serialMerges++;
+        }
+    }
+    
+    ConcurrentUnionFind concurrent(kConcurrentTestNodes);
+    ConcurrentTestState state;
+    state.uFind = &concurrent;
+    state.merges = 0;
+    parallelFor(numTestEdges, uniteTestEdges, &state);
+    if (state.merges != serialMerges) error("concurrent unite errored");
+    for (int nodeNum = 0; nodeNum < kConcurrentTestNodes; nodeNum++) {
+        // each node is in the same set as its root under the other
+        //   structure, so both structures hold exactly the same sets
+        if (!concurrent.connected(nodeNum, serial.findIndex(nodeNum)) ||
+            !serial.connected(nodeNum, concurrent.findIndex(nodeNum))) {
+            error("concurrent unite errored");
+        }
+    }
+
+    // the concurrent structure labels whole worlds, so it must hold more
+    //   nodes than a 16-bit index allows even when UnionFind is built small
+    const int kBigConcurrentNodes = 70000;
+    ConcurrentUnionFind big(kBigConcurrentNodes);
+    if (!big.unite(0, kBigConcurrentNodes - 1)) {
+        error("concurrent unite errored");
+    }
+    if (big.findIndex(0) != kBigConcurrentNodes - 1 ||
+        big.connected(1, kBigConcurrentNodes - 1)) {
+        error("concurrent unite errored");
+    }
+
+    // an error on a worker thread is reported again on this one
+    bool reported = false;
+    try {
+        int numNodes = kConcurrentTestNodes;
+        parallelFor(numNodes, failLastChunk, &numNodes);
+    } catch (ErrorException& ex) {
+        reported = ex.getMessage() == "last chunk failed";
+    }
+    if (!reported) error("parallelFor errored");
+
+    // joins made after a snapshot can be undone, back to any earlier
+    //   snapshot
+    RollbackUnionFind undoable(6, 2);
+    for (int nodeNum = 0; nodeNum < 6; nodeNum++) {
+        undoable.makeSet(nodeNum);
+    }
+    undoable.unite(0, 1);
+    int first = undoable.snapshot();
+    if (!undoable.unite(2, 3)) error("rollback unite errored");
+    if (!undoable.join(makeLoc(1, 1), makeLoc(0, 0))) {
+        error("rollback join errored");
+    }
+    int second = undoable.snapshot();
+    if (!undoable.unite(4, 5)) error("rollback unite errored");
+    if (!undoable.unite(5, 0)) error("rollback unite errored");
+    if (undoable.unite(4, 2)) error("rollback unite errored");
+    
+    undoable.rollback(second);
+    if (!undoable.connected(0, 3)) error("rollback errored");
+    if (undoable.connected(4, 5)) error("rollback errored");
+    if (undoable.connected(4, 0)) error("rollback errored");
+    
+    undoable.rollback(first);
+    if (!undoable.connected(0, 1)) error("rollback errored");
+    if (undoable.connected(2, 3)) error("rollback errored");
+    if (undoable.connected(1, 3)) error("rollback errored");
+    
+    // after undoing, joining again builds the same sets as before
+    if (!undoable.unite(3, 2)) error("rollback unite errored");
+    if (!undoable.unite(1, 2)) error("rollback unite errored");
+    if (undoable.find(makeLoc(0, 0)) != undoable.find(makeLoc(1, 1))) {
+        error("rollback find errored");
+    }
+    undoable.rollback(0);
+    for (int nodeNum = 0; nodeNum < 6; nodeNum++) {
+        if (undoable.findIndex(nodeNum) != nodeNum) error("rollback errored");
+    }
 }
 
 #endif
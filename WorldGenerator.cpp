@@ -9,10 +9,15 @@
 #include "TrailblazerConstants.h"
 #include "vector.h"
 #include "set.h"
-#include "random.h"
+#include "FastRandom.h"
+#include "Parallel.h"
 #include <cmath>
 #include <algorithm>
 #include <limits>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 using namespace std;
 
 /*** Internal constants ***/
@@ -37,29 +42,38 @@ const int kWindowSize = int(kSigma * 6.0 + 0.5);
 
 /*** Internal function prototypes ***/
 
-static void diamondStep(Grid<double>& heights, int size, double variation);
+struct DiamondSquareState;
+
+static void diamondStep(DiamondSquareState& state);
 static double diamondStepAverage(Grid<double>& heights, int size,
                                  int row, int col);
-static void squareStep(Grid<double>& heights, int size, double variation);
+static void squareStep(DiamondSquareState& state);
 static double squareStepAverage(Grid<double>& heights, int size, 
                                 int row, int col);
 
-static Grid<double> wallsToGrid(Set<Edge>& walls, int numRows, int numCols);
+static Grid<double> wallsToGrid(PackedMaze& maze);
 static void smoothTerrain(Grid<double>& toSmooth);
-static void normalizeTerrain(Grid<double>& heights);
-static void flattenValleys(Grid<double>& heights);
-static void diamondSquareGenerate(Grid<double>& heights);
+static void normalizeAndFlattenTerrain(Grid<double>& heights);
+static void diamondSquareGenerate(Grid<double>& heights, uint64_t seed);
 
 /*** Function implementations ***/
 
 /* Generates a random terrain of the specified size. */
 Grid<double> generateRandomTerrain(int numRows, int numCols) {
+  FastRandom random;
+  uint64_t seed = ((uint64_t) random.nextBits() << 32) | random.nextBits();
+  return generateRandomTerrain(numRows, numCols, seed);
+}
+
+/* Generates the random terrain of the specified size for the given seed.
+ * Every stage runs across all of the cores, one band of rows per thread.
+ */
+Grid<double> generateRandomTerrain(int numRows, int numCols, uint64_t seed) {
   Grid<double> heights(numRows, numCols);
 
-  diamondSquareGenerate(heights);
+  diamondSquareGenerate(heights, seed);
   smoothTerrain(heights);
-  normalizeTerrain(heights);
-  flattenValleys(heights);
+  normalizeAndFlattenTerrain(heights);
   return heights;
 }
 
@@ -67,109 +81,227 @@ Grid<double> generateRandomTerrain(int numRows, int numCols) {
  * render it into a grid.
  */
 Grid<double> generateRandomMaze(int numRows, int numCols) {
-  Set<Edge> maze = createMaze(numRows, numCols);
-  return wallsToGrid(maze, numRows, numCols);
+  return generateRandomMaze(numRows, numCols, KRUSKAL_MAZE);
+}
+
+/* Generates a random maze with the given algorithm and renders it into a
+ * grid.
+ */
+Grid<double> generateRandomMaze(int numRows, int numCols,
+                                MazeAlgorithm algorithm) {
+  PackedMaze maze = createPackedMaze(numRows, numCols, algorithm);
+  return wallsToGrid(maze);
+}
+
+/* Generates the random maze for the given algorithm and seed and renders it
+ * into a grid.
+ */
+Grid<double> generateRandomMaze(int numRows, int numCols,
+                                MazeAlgorithm algorithm, uint64_t seed) {
+  FastRandom random(seed);
+  PackedMaze maze = createPackedMaze(numRows, numCols, algorithm, random);
+  return wallsToGrid(maze);
 }
 
 /*** Internal function implementations ***/
 
+/* The state shared by the threads running one step of the diamond-square
+ * algorithm.  level counts the steps, so that every step draws different
+ * random numbers.
+ */
+struct DiamondSquareState {
+  Grid<double>* heights;
+  int size;
+  double variation;
+  uint64_t seed;
+  int level;
+};
+
+/* Returns the random offset, in the range [-variation, variation), added to
+ * the cell at (row, col) in the current step.  It is worked out from the seed,
+ * the step and the cell alone rather than drawn from a shared generator, so
+ * the terrain is the same however the rows are split between threads.
+ */
+static double randomOffset(DiamondSquareState& state, int row, int col) {
+  uint64_t cell = (uint64_t) row * state.heights->numCols() + col;
+  uint64_t bits = hashBits(state.seed ^
+                           hashBits(((uint64_t) state.level << 48) ^ cell));
+  double unit = (bits >> 11) * (1.0 / 9007199254740992.0);
+  return (2.0 * unit - 1.0) * state.variation;
+}
+
 /* Using the diamond-square algorithm (also called the plasma fractal), generate
  * an initial terrain.
  */
-static void diamondSquareGenerate(Grid<double>& heights) {
+static void diamondSquareGenerate(Grid<double>& heights, uint64_t seed) {
+  DiamondSquareState state;
+  state.heights = &heights;
+  state.seed = seed;
+  state.level = 0;
+
   /* The size of each of the squares in the diamond-square algorithm. */
-  int size = (min(heights.numRows(), heights.numCols()) - 1) / 2;
-  double variation = 1.0;
-
-  /* Continue running iterations until the square size shrinks down to 0. */
-  while (size > 0) {
-    diamondStep(heights, size, variation);
-    squareStep(heights, size, variation);
-    size /= 2;
-    variation *= kTerrainShrinkFactor;
+  state.size = (min(heights.numRows(), heights.numCols()) - 1) / 2;
+  state.variation = 1.0;
+
+  /* Continue running iterations until the square size shrinks down to 0.  The
+   * cells set by a diamond step (or a square step) only depend on cells set
+   * in earlier steps, so each step can be split between threads.
+   */
+  while (state.size > 0) {
+    diamondStep(state);
+    state.level++;
+    squareStep(state);
+    state.level++;
+    state.size /= 2;
+    state.variation *= kTerrainShrinkFactor;
   }
 }
 
-/* Given a terrain whose heights are variable, normalize the terrain heights
- * to the range [0, 1].
+/* The state shared by the threads finding the range of heights: each band
+ * of rows records its own lowest and highest heights.
  */
-static void normalizeTerrain(Grid<double>& heights) {
-  /* Compute the maximum and minimum heights. */
-  double maxHeight = -numeric_limits<double>::infinity();
-  double minHeight = numeric_limits<double>::infinity();
-  for (int row = 0; row < heights.numRows(); row++) {
-    for (int col = 0; col < heights.numCols(); col++) {
-      maxHeight = max(maxHeight, heights[row][col]);
-      minHeight = min(minHeight, heights[row][col]);
+struct HeightRangeState {
+  Grid<double>* heights;
+  int numBands;
+  vector<double> bandMin;
+  vector<double> bandMax;
+  double minHeight;
+  double range;
+};
+
+/* parallelFor body: find the lowest and highest heights of bands [begin, end).
+ */
+static void findBandRanges(int begin, int end, void* data) {
+  HeightRangeState* state = (HeightRangeState*) data;
+  Grid<double>& heights = *state->heights;
+  for (int band = begin; band < end; band++) {
+    int firstRow = int((long long) heights.numRows() * band / state->numBands);
+    int lastRow = int((long long) heights.numRows() * (band + 1) /
+                      state->numBands);
+    double maxHeight = -numeric_limits<double>::infinity();
+    double minHeight = numeric_limits<double>::infinity();
+    for (int row = firstRow; row < lastRow; row++) {
+      const double* rowHeights = heights.rowData(row);
+      for (int col = 0; col < heights.numCols(); col++) {
+        maxHeight = max(maxHeight, rowHeights[col]);
+        minHeight = min(minHeight, rowHeights[col]);
+      }
     }
+    state->bandMin[band] = minHeight;
+    state->bandMax[band] = maxHeight;
   }
-  
-  /* Remap everything from the range [minHeight, maxHeight] to [0, 1]. */
-  double range = maxHeight - minHeight;
-  for (int row = 0; row < heights.numRows(); row++) {
+}
+
+/* parallelFor body: normalize and flatten rows [begin, end). */
+static void normalizeAndFlattenRows(int begin, int end, void* data) {
+  HeightRangeState* state = (HeightRangeState*) data;
+  Grid<double>& heights = *state->heights;
+  for (int row = begin; row < end; row++) {
+    double* rowHeights = heights.rowData(row);
     for (int col = 0; col < heights.numCols(); col++) {
-      heights[row][col] -= minHeight;
-      heights[row][col] /= range;
+      double height = (rowHeights[col] - state->minHeight) / state->range;
+      rowHeights[col] = height * height;
     }
   }
 }
 
-/* To make the terrain more interesting, square eight height.  This has the
- * effect of depressing valleys further and sharpening peaks.
+/* Given a terrain whose heights are variable, normalize the terrain heights
+ * to the range [0, 1].  Then, to make the terrain more interesting, square
+ * each height.  This has the effect of depressing valleys further and
+ * sharpening peaks.  Both are done in the same pass over the terrain.
  */
-static void flattenValleys(Grid<double>& heights) {
-  for (int row = 0; row < heights.numRows(); row++) {
-    for (int col = 0; col < heights.numCols(); col++) {
-      heights[row][col] *= heights[row][col];
-    }
+static void normalizeAndFlattenTerrain(Grid<double>& heights) {
+  /* Compute the maximum and minimum heights, one band of rows per thread. */
+  HeightRangeState state;
+  state.heights = &heights;
+  state.numBands = min(numWorkerThreads(), max(heights.numRows(), 1));
+  state.bandMin.resize(state.numBands);
+  state.bandMax.resize(state.numBands);
+  parallelFor(state.numBands, findBandRanges, &state);
+
+  double maxHeight = -numeric_limits<double>::infinity();
+  double minHeight = numeric_limits<double>::infinity();
+  for (int band = 0; band < state.numBands; band++) {
+    maxHeight = max(maxHeight, state.bandMax[band]);
+    minHeight = min(minHeight, state.bandMin[band]);
   }
+
+  /* Remap everything from the range [minHeight, maxHeight] to [0, 1], and
+   * square it.
+   */
+  state.minHeight = minHeight;
+  state.range = maxHeight - minHeight;
+  parallelFor(heights.numRows(), normalizeAndFlattenRows, &state);
 }
 
-/* Performs a diamond step in the diamond-square algorithm, averaging out the
- * value of each cell based on the cells in the same diamond as it.
+/* parallelFor body: run the diamond step on the diamond rows [begin, end),
+ * counting from the first one.
  */
-static void diamondStep(Grid<double>& heights, int size, double variation) {
+static void diamondRows(int begin, int end, void* data) {
+  DiamondSquareState& state = *(DiamondSquareState*) data;
+  Grid<double>& heights = *state.heights;
+  int size = state.size;
   int stride = size * 2;
-  for (int row = size; row < heights.numRows(); row += stride) {
+  for (int i = begin; i < end; i++) {
+    int row = size + i * stride;
     for (int col = size; col < heights.numCols(); col += stride) {
-      heights[row][col] = diamondStepAverage(heights, size, row, col) +
-                          randomReal(-variation, variation);
+      heights.unchecked(row, col) = diamondStepAverage(heights, size,
+                                                       row, col) +
+                                    randomOffset(state, row, col);
     }
   }
 }
 
+/* Performs a diamond step in the diamond-square algorithm, averaging out the
+ * value of each cell based on the cells in the same diamond as it.
+ */
+static void diamondStep(DiamondSquareState& state) {
+  int numDiamondRows = (state.heights->numRows() + state.size - 1) /
+                       (state.size * 2);
+  parallelFor(numDiamondRows, diamondRows, &state);
+}
+
 /* Computes the average of four grid points in a diamond around the specified
  * location.
  */
 static double diamondStepAverage(Grid<double>& heights, int size, 
                                  int row, int col) {
-  double sum = heights[row - size][col - size] +
-               heights[row - size][col + size] +
-               heights[row + size][col - size] +
-               heights[row + size][col + size];
+  double sum = heights.unchecked(row - size, col - size) +
+               heights.unchecked(row - size, col + size) +
+               heights.unchecked(row + size, col - size) +
+               heights.unchecked(row + size, col + size);
   return sum / 4.0;
 }
 
-/* Performs a square step in the diamond-square algorithm, averaging each
- * cell with the values of neighbors in a square pattern near it.
+/* parallelFor body: run the square step on rows [begin, end) of those that
+ * are a multiple of the size.  The rows halfway between two corners set the
+ * cells in line with the corners, and the rows of corners set the cells
+ * halfway between them; neither depends on the other.
  */
-static void squareStep(Grid<double>& heights, int size, double variation) {
+static void squareRows(int begin, int end, void* data) {
+  DiamondSquareState& state = *(DiamondSquareState*) data;
+  Grid<double>& heights = *state.heights;
+  int size = state.size;
   int stride = size * 2;
-  for (int row = size; row < heights.numRows(); row += stride) {
-    for (int col = 0; col < heights.numCols(); col += stride) {
-      heights[row][col] = squareStepAverage(heights, size, row, col) +
-                          randomReal(-variation, variation);
-    }
-  }
-  
-  for (int row = 0; row < heights.numRows(); row += stride) {
-    for (int col = size; col < heights.numCols(); col += stride) {
-      heights[row][col] = squareStepAverage(heights, size, row, col) +
-                          randomReal(-variation, variation);
+  for (int i = begin; i < end; i++) {
+    int row = i * size;
+    int firstCol = i % 2 == 1 ? 0 : size;
+    for (int col = firstCol; col < heights.numCols(); col += stride) {
+      heights.unchecked(row, col) = squareStepAverage(heights, size,
+                                                      row, col) +
+                                    randomOffset(state, row, col);
     }
   }
 }
 
+/* Performs a square step in the diamond-square algorithm, averaging each
+ * cell with the values of neighbors in a square pattern near it.
+ */
+static void squareStep(DiamondSquareState& state) {
+  int numSquareRows = (state.heights->numRows() + state.size - 1) / state.size;
+  parallelFor(numSquareRows, squareRows, &state);
+}
+
 /* Computes the average of all cells in the same square as the given cell. */
 static double squareStepAverage(Grid<double>& heights, int size, 
                                 int row, int col) {
@@ -177,112 +309,233 @@ static double squareStepAverage(Grid<double>& heights, int size,
   int count = 0;
 	
   if (row - size >= 0) {
-    sum += heights[row - size][col];
+    sum += heights.unchecked(row - size, col);
     count++;
   }
   if (row + size < heights.numRows()) {
-    sum += heights[row + size][col];
+    sum += heights.unchecked(row + size, col);
     count++;
   }
   if (col - size >= 0) {
-    sum += heights[row][col - size];
+    sum += heights.unchecked(row, col - size);
     count++;
   }
   if (col + size < heights.numCols()) {
-    sum += heights[row][col + size];
+    sum += heights.unchecked(row, col + size);
     count++;
   }
   
   return sum / count;
 }
 
-/* Creates a kernel matrix that can be used for a Gaussian blur. */
-static Grid<double> createGaussianKernel() {
-	Grid<double> result(kWindowSize, kWindowSize);
-	for (int i = 0; i < kWindowSize; i++) {
-		for (int j = 0; j < kWindowSize; j++) {
-      /* We want to compute
-       *
-       * (1 / sqrt(2 pi sigma) * e^{(x^2 + y^2) / 2(sigma^2)}
-       *
-       * Sorry it's messy!
-       */
-			result[i][j] = exp(-(pow(i - kWindowSize / 2.0, 2.0) +
-													 pow(j - kWindowSize / 2.0, 2.0)) / 
-                         (2 * kSigma * kSigma)) /
-                    sqrt(2 * kPi * kSigma);
-		}
-	}
-	return result;
+/* Creates the weights of a Gaussian kernel along one axis.  The two-dimensional
+ * kernel is
+ *
+ * (1 / sqrt(2 pi sigma) * e^{-(x^2 + y^2) / 2(sigma^2)}
+ *
+ * which is the product of e^{-x^2 / 2(sigma^2)} and e^{-y^2 / 2(sigma^2)}
+ * times a constant.  Every blurred value is divided by the total weight used,
+ * so the constant cancels out and the blur can be done one axis at a time.
+ * Weight a goes with the sample a - kWindowSize / 2 cells away.
+ */
+static vector<double> createGaussianWeights() {
+  vector<double> result(kWindowSize);
+  for (int a = 0; a < kWindowSize; a++) {
+    result[a] = exp(-pow(a - kWindowSize / 2.0, 2.0) / (2 * kSigma * kSigma));
+  }
+  return result;
+}
+
+/* Given the weights along one axis, returns for each of the length positions
+ * along that axis one over the total weight of the samples that are in
+ * bounds.  Only positions near the borders lose any samples.
+ */
+static vector<double> createBlurScales(const vector<double>& weights,
+                                       int length) {
+  vector<double> result(length);
+  for (int i = 0; i < length; i++) {
+    double totalWeightUsed = 0.0;
+    for (int a = 0; a < kWindowSize; a++) {
+      int sample = i + a - kWindowSize / 2;
+      if (sample >= 0 && sample < length) totalWeightUsed += weights[a];
+    }
+    result[i] = 1.0 / totalWeightUsed;
+  }
+  return result;
+}
+
+/* Blurs one row horizontally from source to dest.  The columns whose samples
+ * are all in bounds are done without any bounds checks, two at a time where
+ * SSE2 is available; only the few columns at either end check their samples.
+ */
+static void blurRow(const double* source, double* dest, int length,
+                    const vector<double>& weights,
+                    const vector<double>& scales) {
+  int half = kWindowSize / 2;
+  int lastInterior = length - kWindowSize + half;
+  int col = 0;
+
+  /* Left border, then the interior, then the right border. */
+  for (; col < length && col < half; col++) {
+    double sum = 0.0;
+    for (int a = 0; a < kWindowSize; a++) {
+      int sample = col + a - half;
+      if (sample >= 0 && sample < length) {
+        sum += weights[a] * source[sample];
+      }
+    }
+    dest[col] = sum * scales[col];
+  }
+#ifdef __SSE2__
+  for (; col + 1 <= lastInterior; col += 2) {
+    __m128d sum = _mm_setzero_pd();
+    for (int a = 0; a < kWindowSize; a++) {
+      __m128d samples = _mm_loadu_pd(source + col + a - half);
+      sum = _mm_add_pd(sum, _mm_mul_pd(_mm_set1_pd(weights[a]), samples));
+    }
+    _mm_storeu_pd(dest + col, _mm_mul_pd(sum, _mm_loadu_pd(&scales[col])));
+  }
+#endif
+  for (; col <= lastInterior; col++) {
+    double sum = 0.0;
+    for (int a = 0; a < kWindowSize; a++) {
+      sum += weights[a] * source[col + a - half];
+    }
+    dest[col] = sum * scales[col];
+  }
+  for (; col < length; col++) {
+    double sum = 0.0;
+    for (int a = 0; a < kWindowSize; a++) {
+      int sample = col + a - half;
+      if (sample >= 0 && sample < length) {
+        sum += weights[a] * source[sample];
+      }
+    }
+    dest[col] = sum * scales[col];
+  }
+}
+
+/* Adds weight times the length values of source to those of dest. */
+static void addWeightedRow(const double* source, double weight, double* dest,
+                           int length) {
+  int col = 0;
+#ifdef __SSE2__
+  __m128d weights = _mm_set1_pd(weight);
+  for (; col + 2 <= length; col += 2) {
+    _mm_storeu_pd(dest + col,
+                  _mm_add_pd(_mm_loadu_pd(dest + col),
+                             _mm_mul_pd(weights,
+                                        _mm_loadu_pd(source + col))));
+  }
+#endif
+  for (; col < length; col++) {
+    dest[col] += weight * source[col];
+  }
 }
 
-/* Applies a Gaussian blur to the maze. */
+/* The state shared by the threads blurring the terrain. */
+struct BlurState {
+  Grid<double>* terrain;
+  vector<double> weights;
+  vector<double> rowScales;
+  vector<double> colScales;
+
+  /* The terrain blurred horizontally, one row after another. */
+  vector<double> blurred;
+};
+
+/* parallelFor body: blur rows [begin, end) of the terrain horizontally into
+ * the buffer.
+ */
+static void blurTerrainRows(int begin, int end, void* data) {
+  BlurState* state = (BlurState*) data;
+  Grid<double>& terrain = *state->terrain;
+  int numCols = terrain.numCols();
+  for (int i = begin; i < end; i++) {
+    blurRow(terrain.rowData(i), &state->blurred[(long long) i * numCols],
+            numCols, state->weights, state->colScales);
+  }
+}
+
+/* parallelFor body: blur the buffer vertically back into rows [begin, end)
+ * of the terrain.
+ */
+static void blurTerrainColumns(int begin, int end, void* data) {
+  BlurState* state = (BlurState*) data;
+  Grid<double>& terrain = *state->terrain;
+  int numRows = terrain.numRows();
+  int numCols = terrain.numCols();
+  int half = kWindowSize / 2;
+  vector<double> row(numCols);
+  for (int i = begin; i < end; i++) {
+    row.assign(numCols, 0.0);
+    for (int a = 0; a < kWindowSize; a++) {
+      int sampleRow = i + a - half;
+      if (sampleRow < 0 || sampleRow >= numRows) continue;
+      addWeightedRow(&state->blurred[(long long) sampleRow * numCols],
+                     state->weights[a], &row[0], numCols);
+    }
+    double* dest = terrain.rowData(i);
+    for (int j = 0; j < numCols; j++) {
+      dest[j] = row[j] * state->rowScales[i];
+    }
+  }
+}
+
+/* Applies a Gaussian blur to the terrain.  Rather than convolving with the
+ * whole kWindowSize x kWindowSize kernel at every point, blur each row
+ * horizontally into a flat buffer, then blur the columns of that buffer
+ * vertically, a whole row at a time.  Near the borders, each axis divides by
+ * the weight it actually used along that axis; since the samples in bounds
+ * always form a rectangle, this is the same as dividing by the total weight
+ * used by the full kernel.  Each pass is split between threads by rows.
+ */
 static void smoothTerrain(Grid<double>& terrain) {
-	Grid<double> kernel = createGaussianKernel();
-	Grid<double> result(terrain.numRows(), terrain.numCols());
-	
-  /* Convolve the two matrices together.  For each point in the original grid,
-   * compute the weighted sum of the Gaussian kernel applied at that point, then
-   * write the result back to the resulting image.
-   */
-	for (int i = 0; i < terrain.numRows(); i++) {
-		for (int j = 0; j < terrain.numCols(); j++) {
-      /* We might not apply the entire kernel if we're on a border, so track
-       * how much total weight was used.
-       */
-			double totalWeightUsed = 0.0;
-			for (int a = 0; a < kernel.numRows(); a++) {
-				for (int b = 0; b < kernel.numCols(); b++) {
-          /* Determine the sample point from the original image.  If it's not
-           * in-bounds, skip it.
-           */
-					int sampleRow = i + a - kernel.numRows() / 2;
-					int sampleCol = j + b - kernel.numRows() / 2;
-					if (!terrain.inBounds(sampleRow, sampleCol)) continue;
-					
-					totalWeightUsed += kernel[a][b];
-					result[i][j] += kernel[a][b] * terrain[sampleRow][sampleCol];
-				}
-			}
-			result[i][j] /= totalWeightUsed;
-		}
-	}
-	
-	terrain = result;
+  int numRows = terrain.numRows();
+  int numCols = terrain.numCols();
+  if (numRows == 0 || numCols == 0) return;
+
+  BlurState state;
+  state.terrain = &terrain;
+  state.weights = createGaussianWeights();
+  state.rowScales = createBlurScales(state.weights, numRows);
+  state.colScales = createBlurScales(state.weights, numCols);
+  state.blurred.resize((long long) numRows * numCols);
+
+  parallelFor(numRows, blurTerrainRows, &state);
+  parallelFor(numRows, blurTerrainColumns, &state);
 }
 
-/* Given a set of walls, converts those walls into a 2D grid. */
-static Grid<double> wallsToGrid(Set<Edge>& walls, int numRows, int numCols) {
+/* Given a maze, converts its passages into a 2D grid. */
+static Grid<double> wallsToGrid(PackedMaze& maze) {
+  int numRows = maze.numRows();
+  int numCols = maze.numCols();
+
   /* We need numRows - 1 interstitial blocks and numRows - 1 interstitial
    * blocks.
    */
   Grid<double> result(2 * numRows - 1, 2 * numCols - 1);
 	
   /* Fill everything in. */
-  for (int i = 0; i < result.numRows(); i++) {
-    for (int j = 0; j < result.numCols(); j++) {
-      result[i][j] = kMazeWall;
-    }
+  double* cells = result.data();
+  for (int i = 0; i < result.numRows() * result.numCols(); i++) {
+    cells[i] = kMazeWall;
   }
 	
-  /* Clear all cells corresponding to grid points. */
+  /* Clear all cells corresponding to grid points, along with the
+   * interstitial cells to their right and below them that correspond to
+   * passages.
+   */
   for (int i = 0; i < numRows; i++) {
     for (int j = 0; j < numCols; j++) {
-      result[2 * i][2 * j] = kMazeFloor;
-    }
-  }
-	
-  /* Clear all interstitial cells corresponding to connections. */
-  foreach (Edge wall in walls) {
-    /* Confirm the endpoints are in-bounds. */
-    if (!result.inBounds(wall.start.row, wall.start.col) ||
-        !result.inBounds(wall.end.row, wall.end.col)) {
-      error("Edge endpoints are out of range.");
+      result.unchecked(2 * i, 2 * j) = kMazeFloor;
+      if (maze.hasRightPassage(i, j)) {
+        result.unchecked(2 * i, 2 * j + 1) = kMazeFloor;
+      }
+      if (maze.hasDownPassage(i, j)) {
+        result.unchecked(2 * i + 1, 2 * j) = kMazeFloor;
+      }
     }
-
-    int row = 2 * wall.start.row + (wall.end.row - wall.start.row);
-    int col = 2 * wall.start.col + (wall.end.col - wall.start.col);
-    result[row][col] = kMazeFloor;
   }
 	
   return result;
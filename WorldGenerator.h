@@ -8,6 +8,8 @@
 #define WorldGenerator_Included
 
 #include "grid.h"
+#include "Trailblazer.h"
+#include <stdint.h>
 
 /* Function: generateRandomTerrain
  *
@@ -16,6 +18,13 @@
  */
 Grid<double> generateRandomTerrain(int numRows, int numCols);
 
+/* Function: generateRandomTerrain
+ *
+ * Generates the random terrain for the given seed.  The same seed always
+ * gives the same terrain, however many threads generate it.
+ */
+Grid<double> generateRandomTerrain(int numRows, int numCols, uint64_t seed);
+
 /* Function: generateRandomMaze
  *
  * Generates a random maze to navigate.  This code will internally call your
@@ -24,4 +33,20 @@ Grid<double> generateRandomTerrain(int numRows, int numCols);
  */
 Grid<double> generateRandomMaze(int numRows, int numCols);
 
+/* Function: generateRandomMaze
+ *
+ * Generates a random maze to navigate, building it with the specified maze
+ * generation algorithm.
+ */
+Grid<double> generateRandomMaze(int numRows, int numCols,
+                                MazeAlgorithm algorithm);
+
+/* Function: generateRandomMaze
+ *
+ * Generates the random maze for the given algorithm and seed.  The same seed
+ * always gives the same maze.
+ */
+Grid<double> generateRandomMaze(int numRows, int numCols,
+                                MazeAlgorithm algorithm, uint64_t seed);
+
 #endif